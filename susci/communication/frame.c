@@ -0,0 +1,163 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores framing of binary data sent through ring buffers, for
+ * example hardware uart. Frame is SLIP encoded payload with CRC-16-CCITT,
+ * sent low byte first. Encoder reads payload directly from memory of the
+ * sender, and decoder writes it directly to memory of the receiver, both
+ * work incrementally, as much as fits into buffers at once.
+ */
+
+#include "../settings.h"
+#include "../kernel/types.h"
+#include "../synchronization/ring_buffer.h"
+#include "frame.h"
+
+#ifdef USE_FRAME
+
+/** \fn start_frame_encoder
+ * This function prepares encoder to send frame with given payload. Payload
+ * must not change until encoder is finished.
+ * @*encoder Frame encoder
+ * @*data Payload of frame
+ * @length Count of payload bytes
+ */
+void start_frame_encoder(
+    frame_encoder_t *encoder,
+    const char *data,
+    uint8_t length
+) {
+    encoder->data = data;
+    encoder->length = length;
+    encoder->crc_left = FRAME_CRC_SIZE;
+    encoder->crc = FRAME_CRC_INIT;
+    encoder->pending = FRAME_END;
+    encoder->finished = false;
+}
+
+/** \fn pump_frame_encoder
+ * This function encodes as much of frame as fits into given buffer. Return
+ * true when whole frame is in buffer.
+ * @*encoder Frame encoder
+ * @*output Buffer to write encoded bytes to
+ */
+bool pump_frame_encoder(frame_encoder_t *encoder, ring_buffer_t *output) {
+    while (!is_ring_buffer_full(output)) {
+        if (encoder->pending != 0x00) {
+            write_ring_buffer(output, (char) encoder->pending);
+            encoder->pending = 0x00;
+
+            continue;
+        }
+
+        if (encoder->finished) break;
+
+        uint8_t data;
+
+        if (encoder->length) {
+            data = (uint8_t) *encoder->data++;
+            -- encoder->length;
+
+            encoder->crc = update_frame_crc(encoder->crc, data);
+        } else if (encoder->crc_left) {
+            data = (uint8_t) encoder->crc;
+            encoder->crc >>= 8;
+            -- encoder->crc_left;
+        } else {
+            encoder->pending = FRAME_END;
+            encoder->finished = true;
+
+            continue;
+        }
+
+        if (data == FRAME_END) {
+            data = FRAME_ESCAPE;
+            encoder->pending = FRAME_ESCAPED_END;
+        } else if (data == FRAME_ESCAPE) {
+            encoder->pending = FRAME_ESCAPED_ESCAPE;
+        }
+
+        write_ring_buffer(output, (char) data);
+    }
+
+    return is_frame_encoder_finished(encoder);
+}
+
+/** \fn end_decoded_frame
+ * This function is called when FRAME_END comes. Frame with good CRC is
+ * marked ready, other not empty frame is dropped.
+ * @*decoder Frame decoder
+ */
+static inline void end_decoded_frame(frame_decoder_t *decoder) {
+    if (
+        !decoder->bad
+        && decoder->length >= FRAME_CRC_SIZE
+        && decoder->crc == 0x0000
+    ) {
+        decoder->length -= FRAME_CRC_SIZE;
+        decoder->ready = true;
+
+        return;
+    }
+
+    if (decoder->bad || decoder->length) {
+        if (decoder->errors != 0xFF) ++ decoder->errors;
+    }
+
+    decoder->bad = false;
+    decoder->escape = false;
+    release_frame(decoder);
+}
+
+/** \fn pump_frame_decoder
+ * This function decodes bytes from given buffer, until frame is ready or
+ * buffer is empty. Return true when verified frame is ready. Bytes are not
+ * read while frame is ready, until it is released.
+ * @*decoder Frame decoder
+ * @*input Buffer to read encoded bytes from
+ */
+bool pump_frame_decoder(frame_decoder_t *decoder, ring_buffer_t *input) {
+    while (!decoder->ready && !is_ring_buffer_empty(input)) {
+        uint8_t data = (uint8_t) read_ring_buffer(input);
+
+        if (data == FRAME_END) {
+            end_decoded_frame(decoder);
+
+            continue;
+        }
+
+        if (decoder->escape) {
+            decoder->escape = false;
+
+            if (data == FRAME_ESCAPED_END) data = FRAME_END;
+            else if (data == FRAME_ESCAPED_ESCAPE) data = FRAME_ESCAPE;
+            else decoder->bad = true;
+        } else if (data == FRAME_ESCAPE) {
+            decoder->escape = true;
+
+            continue;
+        }
+
+        if (decoder->length >= decoder->size) {
+            decoder->bad = true;
+
+            continue;
+        }
+
+        decoder->buffer[decoder->length++] = (char) data;
+        decoder->crc = update_frame_crc(decoder->crc, data);
+    }
+
+    return decoder->ready;
+}
+
+#endif
@@ -0,0 +1,257 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores framing of binary data sent through ring buffers, for
+ * example hardware uart. Frame is SLIP encoded payload with CRC-16-CCITT,
+ * sent low byte first. Encoder reads payload directly from memory of the
+ * sender, and decoder writes it directly to memory of the receiver, both
+ * work incrementally, as much as fits into buffers at once.
+ */
+
+#include "../settings.h"
+#include "../kernel/types.h"
+#include "../synchronization/ring_buffer.h"
+
+#ifdef USE_HARDWARE_UART
+#include "../drivers/integrated/hardware_uart.h"
+#endif
+
+#ifndef COMMUNICATION_FRAME_H_INCLUDED
+#define COMMUNICATION_FRAME_H_INCLUDED
+
+#ifdef USE_FRAME
+
+/** \def FRAME_END
+ * Byte that ends frame, it is also sent before frame, so noise on the line
+ * is ended as bad frame.
+ */
+#define FRAME_END 0xC0
+
+/** \def FRAME_ESCAPE
+ * Byte that starts escape sequence for FRAME_END and FRAME_ESCAPE in data.
+ */
+#define FRAME_ESCAPE 0xDB
+
+/** \def FRAME_ESCAPED_END
+ * Byte after FRAME_ESCAPE that means FRAME_END in data.
+ */
+#define FRAME_ESCAPED_END 0xDC
+
+/** \def FRAME_ESCAPED_ESCAPE
+ * Byte after FRAME_ESCAPE that means FRAME_ESCAPE in data.
+ */
+#define FRAME_ESCAPED_ESCAPE 0xDD
+
+/** \def FRAME_CRC_INIT
+ * Initial value of CRC of every frame.
+ */
+#define FRAME_CRC_INIT 0xFFFF
+
+/** \def FRAME_CRC_SIZE
+ * Count of CRC bytes at end of every frame.
+ */
+#define FRAME_CRC_SIZE 2
+
+/** \struct frame_encoder_t
+ * This struct stores state of frame that is sending.
+ */
+typedef struct {
+
+    /* Payload that is not encoded yet */
+    const char *data;
+
+    /* Count of payload bytes that are not encoded yet */
+    uint8_t length;
+
+    /* Count of CRC bytes that are not encoded yet */
+    uint8_t crc_left;
+
+    /* CRC of encoded payload */
+    uint16_t crc;
+
+    /* Byte that must be sent next, or 0x00 */
+    uint8_t pending;
+
+    /* All bytes of frame are encoded, closing FRAME_END can be pending */
+    bool finished;
+
+} frame_encoder_t;
+
+/** \struct frame_decoder_t
+ * This struct stores state of frame that is receiving.
+ */
+typedef struct {
+
+    /* Memory for payload and CRC */
+    char *buffer;
+
+    /* Size of memory in bytes */
+    uint8_t size;
+
+    /* Count of received bytes, or payload length when frame is ready */
+    uint8_t length;
+
+    /* CRC of received bytes, it is 0x0000 after good CRC */
+    uint16_t crc;
+
+    /* Last byte was FRAME_ESCAPE */
+    bool escape;
+
+    /* Frame is bad, it is dropped when it ends */
+    bool bad;
+
+    /* Verified frame is in memory, until it is released */
+    bool ready;
+
+    /* Count of dropped bad frames */
+    uint8_t errors;
+
+} frame_decoder_t;
+
+/** \def DECLARE_FRAME_DECODER
+ * Declares frame decoder with given name and memory for frames with given
+ * max payload size. Memory is named name_area.
+ */
+#define DECLARE_FRAME_DECODER(name, max_payload) \
+    char name##_area[(max_payload) + FRAME_CRC_SIZE]; \
+    frame_decoder_t name = { \
+        name##_area, \
+        sizeof(name##_area), \
+        0x00, \
+        FRAME_CRC_INIT, \
+        false, \
+        false, \
+        false, \
+        0x00 \
+    }
+
+/** \fn update_frame_crc
+ * This function returns CRC-16-CCITT updated with given byte, it is the
+ * same CRC as _crc_ccitt_update from avr-libc, without table.
+ * @crc Current CRC
+ * @data Next byte
+ */
+static inline uint16_t update_frame_crc(uint16_t crc, uint8_t data) {
+    data ^= (uint8_t) crc;
+    data ^= (uint8_t) (data << 4);
+
+    return (uint16_t) (
+        (((uint16_t) data << 8) | (uint8_t) (crc >> 8))
+        ^ (uint8_t) (data >> 4)
+        ^ ((uint16_t) data << 3)
+    );
+}
+
+/** \fn start_frame_encoder
+ * This function prepares encoder to send frame with given payload. Payload
+ * must not change until encoder is finished.
+ * @*encoder Frame encoder
+ * @*data Payload of frame
+ * @length Count of payload bytes
+ */
+void start_frame_encoder(
+    frame_encoder_t *encoder,
+    const char *data,
+    uint8_t length
+);
+
+/** \fn pump_frame_encoder
+ * This function encodes as much of frame as fits into given buffer. Return
+ * true when whole frame is in buffer.
+ * @*encoder Frame encoder
+ * @*output Buffer to write encoded bytes to
+ */
+bool pump_frame_encoder(frame_encoder_t *encoder, ring_buffer_t *output);
+
+/** \fn is_frame_encoder_finished
+ * This function returns true when whole frame, with closing FRAME_END, is
+ * in output buffer, and encoder can start next frame.
+ * @*encoder Frame encoder
+ */
+static inline bool is_frame_encoder_finished(frame_encoder_t *encoder) {
+    return (bool) (encoder->finished && encoder->pending == 0x00);
+}
+
+/** \fn pump_frame_decoder
+ * This function decodes bytes from given buffer, until frame is ready or
+ * buffer is empty. Return true when verified frame is ready. Bytes are not
+ * read while frame is ready, until it is released.
+ * @*decoder Frame decoder
+ * @*input Buffer to read encoded bytes from
+ */
+bool pump_frame_decoder(frame_decoder_t *decoder, ring_buffer_t *input);
+
+/** \fn get_frame_data
+ * This function returns payload of ready frame.
+ * @*decoder Frame decoder
+ */
+static inline const char *get_frame_data(frame_decoder_t *decoder) {
+    return decoder->buffer;
+}
+
+/** \fn get_frame_length
+ * This function returns count of payload bytes of ready frame.
+ * @*decoder Frame decoder
+ */
+static inline uint8_t get_frame_length(frame_decoder_t *decoder) {
+    return decoder->length;
+}
+
+/** \fn get_frame_errors
+ * This function returns count of dropped bad frames.
+ * @*decoder Frame decoder
+ */
+static inline uint8_t get_frame_errors(frame_decoder_t *decoder) {
+    return decoder->errors;
+}
+
+/** \fn release_frame
+ * This function releases ready frame, so decoder can receive next one.
+ * @*decoder Frame decoder
+ */
+static inline void release_frame(frame_decoder_t *decoder) {
+    decoder->length = 0x00;
+    decoder->crc = FRAME_CRC_INIT;
+    decoder->ready = false;
+}
+
+#ifdef USE_HARDWARE_UART
+
+/** \fn send_uart_frame
+ * This function encodes as much of frame as fits into hardware uart
+ * transmit buffer, and starts sending it. Return true when whole frame is
+ * in buffer, else call it again, for example on HARDWARE_UART_LOW_SIGNAL.
+ * @*encoder Frame encoder
+ */
+static inline bool send_uart_frame(frame_encoder_t *encoder) {
+    bool finished = pump_frame_encoder(encoder, &hardware_uart_sender);
+
+    start_hardware_uart();
+
+    return finished;
+}
+
+/** \fn receive_uart_frame
+ * This function decodes bytes received by hardware uart. Return true when
+ * verified frame is ready. Receiver is woken up by FRAME_END, so call it
+ * after HARDWARE_UART_RECEIVED_SIGNAL.
+ * @*decoder Frame decoder
+ */
+static inline bool receive_uart_frame(frame_decoder_t *decoder) {
+    return pump_frame_decoder(decoder, &hardware_uart_receiver);
+}
+
+#endif
+
+#endif
+
+#endif
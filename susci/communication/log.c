@@ -0,0 +1,113 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores binary log. Device does not format text, it stores only
+ * id of message from log_messages.h and raw arguments in buffer, and process
+ * sends them through hardware uart. Text is made on the host by
+ * tools/log_decoder.py.
+ */
+
+#include "../settings.h"
+#include "../kernel/types.h"
+#include "../kernel/process.h"
+#include "../kernel/scheduler.h"
+#include "../kernel/platform.h"
+#include "../synchronization/ring_buffer.h"
+#include "../drivers/integrated/hardware_uart.h"
+#include "log.h"
+
+#ifdef USE_LOG
+
+DECLARE_RING_BUFFER(log_buffer, char, LOG_SIZE);
+
+/** \var log_dropped
+ * Count of records dropped because log was full.
+ */
+static volatile uint8_t log_dropped;
+
+/** \fn log_message
+ * This function stores record with given message id and arguments in log.
+ * When whole record does not fit, it is dropped. It is safe to call it from
+ * interrupt.
+ * @id Id of message
+ * @*arguments Raw arguments, little endian
+ * @length Count of bytes of arguments
+ */
+void log_message(log_id_t id, const void *arguments, uint8_t length) {
+    /* Processes and interrupts can write at once, so record is atomic */
+    uint8_t state = platform_lock();
+
+    /* Record bigger than uart buffer could never be sent */
+    if (
+        1 + LOG_HEADER_SIZE + length > UART_TX_SIZE
+        || get_ring_buffer_free(&log_buffer) < LOG_HEADER_SIZE + length
+    ) {
+        if (log_dropped != 0xFF) ++ log_dropped;
+    } else {
+        write_ring_buffer(&log_buffer, (char) id);
+        write_ring_buffer(&log_buffer, (char) length);
+        write_ring_buffer_span(&log_buffer, arguments, length);
+    }
+
+    platform_unlock(state);
+}
+
+/** \fn get_log_dropped
+ * This function returns count of records dropped because log was full.
+ */
+uint8_t get_log_dropped(void) {
+    return log_dropped;
+}
+
+/** \fn log_service
+ * This is service for log. It moves whole records from log buffer to
+ * hardware uart transmit buffer, when they fit. You must set nullptr as
+ * param for this process.
+ */
+exec_state_t log_service(void *param) {
+    exec_state_t state = IDLE_STATE;
+
+    while (!is_ring_buffer_empty(&log_buffer)) {
+        /* Record is written at once, so it is whole when its id is here */
+        uint8_t length = LOG_HEADER_SIZE + (uint8_t) peek_ring_buffer(
+            &log_buffer,
+            1
+        );
+
+        if (get_hardware_uart_free() < 1 + length) break;
+
+        write_ring_buffer(&hardware_uart_sender, (char) LOG_SYNC);
+
+        while (length--) {
+            write_ring_buffer(
+                &hardware_uart_sender,
+                read_ring_buffer(&log_buffer)
+            );
+        }
+
+        state = GOOD_STATE;
+    }
+
+    if (state == GOOD_STATE) start_hardware_uart();
+
+    return state;
+}
+
+/** \fn enable_log
+ * This function creates new process in system for log_service. Hardware
+ * uart must be enabled too.
+ */
+void enable_log(void) {
+    create_process(get_first_empty(), log_service, nullptr);
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores binary log. Device does not format text, it stores only
+ * id of message from log_messages.h and raw arguments in buffer, and process
+ * sends them through hardware uart. Text is made on the host by
+ * tools/log_decoder.py.
+ */
+
+#include "../settings.h"
+#include "../kernel/types.h"
+#include "../kernel/process.h"
+#include "../synchronization/ring_buffer.h"
+
+#ifndef COMMUNICATION_LOG_H_INCLUDED
+#define COMMUNICATION_LOG_H_INCLUDED
+
+#ifdef USE_LOG
+
+/** \def LOG_SIZE
+ * Size of log buffer, it must be power of two, up to 128.
+ */
+#ifndef LOG_SIZE
+#define LOG_SIZE 32
+#endif
+
+/** \def LOG_SYNC
+ * Byte sent before every record, so host can find start of record.
+ */
+#define LOG_SYNC 0xA5
+
+/** \def LOG_HEADER_SIZE
+ * Count of bytes before arguments in every record, id and length.
+ */
+#define LOG_HEADER_SIZE 2
+
+/** \enum log_id_t
+ * Ids of messages, in order from log_messages.h.
+ */
+typedef enum {
+
+#define LOG_MESSAGE(name, format) name,
+#include "../log_messages.h"
+#undef LOG_MESSAGE
+
+    /* Count of messages */
+    LOG_MESSAGES_COUNT
+
+} log_id_t;
+
+/** \var log_buffer
+ * Buffer with records that are not sent yet.
+ */
+extern ring_buffer_t log_buffer;
+
+/** \fn log_message
+ * This function stores record with given message id and arguments in log.
+ * When whole record does not fit, it is dropped. It is safe to call it from
+ * interrupt.
+ * @id Id of message
+ * @*arguments Raw arguments, little endian
+ * @length Count of bytes of arguments
+ */
+void log_message(log_id_t id, const void *arguments, uint8_t length);
+
+/** \fn log_event
+ * This function stores record without arguments in log.
+ * @id Id of message
+ */
+static inline void log_event(log_id_t id) {
+    log_message(id, nullptr, 0x00);
+}
+
+/** \fn log_value
+ * This function stores record with one 2 bytes argument in log.
+ * @id Id of message
+ * @value Argument of message
+ */
+static inline void log_value(log_id_t id, uint16_t value) {
+    log_message(id, &value, sizeof(value));
+}
+
+/** \fn get_log_dropped
+ * This function returns count of records dropped because log was full.
+ */
+uint8_t get_log_dropped(void);
+
+/** \fn log_service
+ * This is service for log. It moves whole records from log buffer to
+ * hardware uart transmit buffer, when they fit. You must set nullptr as
+ * param for this process.
+ */
+exec_state_t log_service(void *param);
+
+/** \fn enable_log
+ * This function creates new process in system for log_service. Hardware
+ * uart must be enabled too.
+ */
+void enable_log(void);
+
+#endif
+
+#endif
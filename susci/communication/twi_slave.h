@@ -99,15 +99,21 @@ typedef struct {
 } twi_interface_t;
 
 /** \fn create_twi_interface
- * This function create new TWI slave interface with new shared memory and
- * device address from given parameter.
+ * This function create new TWI slave interface with new shared memory on
+ * given memory space and device address from given parameter.
  * @address Address of slave device in new bus
+ * @*area Memory space shared by slave device
+ * @size Size of memory space in bytes
  */
-static inline twi_interface_t create_twi_interface(twi_address_t address) {
+static inline twi_interface_t create_twi_interface(
+    twi_address_t address,
+    volatile char *area,
+    uint8_t size
+) {
     return (twi_interface_t) {
     	BUS_OFF,
     	address,
-    	create_shared_memory ()
+    	create_shared_memory(area, size)
     };
 }
 
@@ -13,9 +13,16 @@
  * microcontroller ADC.
  */
  
+#include "../../kernel/types.h"
+
 #ifndef DRIVERS_INTEGRATED_ADC_H_INCLUDED
 #define DRIVERS_INTEGRATED_ADC_H_INCLUDED
 
+/** \def ADC_COMPLETE_SIGNAL
+ * Signal made when conversion started by start_adc_conversion is complete.
+ */
+#define ADC_COMPLETE_SIGNAL 0x40
+
 /** \typedef adc_t
  * This is type for adc mux selector
  */
@@ -26,6 +33,11 @@ typedef uint8_t adc_mux_t;
  */
 typedef uint16_t adc_result_t;
 
+/** \def ADC_BUSY_RESULT
+ * Result of read_from_adc when ADC is busy, it is never read from ADC.
+ */
+#define ADC_BUSY_RESULT ((adc_result_t) 0xFFFF)
+
 /** \fn setup_adc_reference
  * This setup voltage reference for ADC.
  * @adc_reference Reference switches for ADC
@@ -33,9 +45,57 @@ typedef uint16_t adc_result_t;
 void setup_adc_reference(adc_mux_t adc_reference);
 
 /** \fn read_from_adc
- * This function return data readed from adc on mux given in parameter.
+ * This function return data readed from adc on mux given in parameter. It
+ * waits for end of conversion, so use start_adc_conversion when You can.
+ * While other conversion or scan is running, it does not touch ADC and
+ * returns ADC_BUSY_RESULT at once.
  * @adc_pin Mux to read from
  */
 adc_result_t read_from_adc(adc_mux_t adc_mux);
 
+/** \fn start_adc_conversion
+ * This function starts conversion on given mux and returns at once. When
+ * conversion is complete, interrupt stores result and makes
+ * ADC_COMPLETE_SIGNAL. Return false when other conversion is running.
+ * @adc_mux Mux to read from
+ */
+bool start_adc_conversion(adc_mux_t adc_mux);
+
+/** \fn start_quiet_adc_conversion
+ * This function prepares conversion on given mux, that is started when no
+ * process has any work, and CPU sleeps in ADC noise reduction mode during
+ * it. Without USE_ADC_NOISE_SLEEP it is started at once, as by
+ * start_adc_conversion. When conversion is complete, interrupt stores
+ * result and makes ADC_COMPLETE_SIGNAL. Return false when other conversion
+ * is running.
+ * @adc_mux Mux to read from
+ */
+bool start_quiet_adc_conversion(adc_mux_t adc_mux);
+
+/** \fn begin_quiet_adc_sleep
+ * A function that should only be called by platform_idle with interrupts
+ * disabled. Return true when quiet conversion waits and sleep can start
+ * it, then it is marked as started. When it waits but CPU can not sleep,
+ * it is started at once, so it never waits forever.
+ * @can_sleep CPU can sleep in ADC noise reduction mode now
+ */
+bool begin_quiet_adc_sleep(bool can_sleep);
+
+/** \fn is_adc_busy
+ * This function returns true while conversion is running.
+ */
+bool is_adc_busy(void);
+
+/** \fn is_adc_ready
+ * This function returns true when result of conversion started by
+ * start_adc_conversion is ready and not taken yet.
+ */
+bool is_adc_ready(void);
+
+/** \fn get_adc_result
+ * This function returns result of last conversion started by
+ * start_adc_conversion, and marks it taken.
+ */
+adc_result_t get_adc_result(void);
+
 #endif
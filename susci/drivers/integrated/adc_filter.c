@@ -0,0 +1,152 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ * This file stores code for ADC filter pipeline. Every sample goes
+ * through median, oversampling, moving average and IIR stages, each of
+ * them can be turned off. All stages use 16 bit integers and shifts only,
+ * so pipeline is cheap enough to run in ADC interrupt.
+ */
+
+#include "../../settings.h"
+#include "../../kernel/types.h"
+#include "adc.h"
+#include "adc_filter.h"
+
+#ifdef USE_ADC_FILTER
+
+/** \fn filter_median
+ * This function puts sample into median window, and returns median of
+ * samples in it. Until window is full, median of samples that came.
+ * @*filter Filter pipeline
+ * @sample New sample
+ */
+static adc_result_t filter_median(adc_filter_t *filter, adc_result_t sample) {
+    filter->median[filter->median_position] = sample;
+
+    if (++ filter->median_position == filter->median_size) {
+        filter->median_position = 0x00;
+    }
+
+    if (filter->median_count < filter->median_size) ++ filter->median_count;
+
+    /* Insertion sort of copy, there are at most 5 samples */
+    adc_result_t sorted[ADC_FILTER_MEDIAN_MAX];
+    uint8_t count = filter->median_count;
+
+    for (uint8_t next = 0; next < count; ++ next) {
+        adc_result_t value = filter->median[next];
+        uint8_t position = next;
+
+        while (position && sorted[position - 1] > value) {
+            sorted[position] = sorted[position - 1];
+            -- position;
+        }
+
+        sorted[position] = value;
+    }
+
+    return sorted[count >> 1];
+}
+
+/** \fn filter_average
+ * This function puts value into moving average window, and returns average
+ * of values in it. Until window is full, average of values that came.
+ * @*filter Filter pipeline
+ * @value New value
+ */
+static adc_result_t filter_average(adc_filter_t *filter, adc_result_t value) {
+    uint8_t size = (uint8_t) (1 << filter->average_shift);
+
+    if (filter->average_count == size) {
+        filter->average_sum -= filter->average[filter->average_position];
+    } else {
+        ++ filter->average_count;
+    }
+
+    filter->average[filter->average_position] = value;
+    filter->average_sum += value;
+    filter->average_position = (filter->average_position + 1) & (size - 1);
+
+    if (filter->average_count == size) {
+        return (adc_result_t) (filter->average_sum >> filter->average_shift);
+    }
+
+    return (adc_result_t) (filter->average_sum / filter->average_count);
+}
+
+/** \fn filter_iir
+ * This function returns output of first order IIR, it takes 1 / 2 to power
+ * of iir_shift of difference between new value and last output.
+ * @*filter Filter pipeline
+ * @value New value
+ */
+static adc_result_t filter_iir(adc_filter_t *filter, adc_result_t value) {
+    if (filter->empty) {
+        filter->iir_state = (uint16_t) (value << filter->iir_shift);
+
+        return value;
+    }
+
+    /* Old output is taken first, so state never exceeds 16 bits */
+    filter->iir_state -= filter->iir_state >> filter->iir_shift;
+    filter->iir_state += value;
+
+    return (adc_result_t) (filter->iir_state >> filter->iir_shift);
+}
+
+/** \fn filter_adc_sample
+ * This function puts sample into pipeline. Return true when new filtered
+ * value is ready, with oversampling it is once per 4 to power of
+ * oversample_shift samples.
+ * @*filter Filter pipeline
+ * @sample Raw sample from ADC
+ */
+bool filter_adc_sample(adc_filter_t *filter, adc_result_t sample) {
+    if (filter->median_size > 1) sample = filter_median(filter, sample);
+
+    if (filter->oversample_shift) {
+        filter->oversample_sum += sample;
+
+        uint8_t needed = (uint8_t) (1 << (filter->oversample_shift << 1));
+
+        if (++ filter->oversample_count < needed) return false;
+
+        sample = (adc_result_t) (
+            filter->oversample_sum >> filter->oversample_shift
+        );
+
+        filter->oversample_sum = 0x0000;
+        filter->oversample_count = 0x00;
+    }
+
+    if (filter->average_shift) sample = filter_average(filter, sample);
+    if (filter->iir_shift) sample = filter_iir(filter, sample);
+
+    filter->value = sample;
+    filter->empty = false;
+
+    return true;
+}
+
+/** \fn reset_adc_filter
+ * This function clears state of pipeline, settings are not changed.
+ * @*filter Filter pipeline
+ */
+void reset_adc_filter(adc_filter_t *filter) {
+    *filter = create_adc_filter(
+        filter->median_size,
+        filter->oversample_shift,
+        filter->average_shift,
+        filter->iir_shift
+    );
+}
+
+#endif
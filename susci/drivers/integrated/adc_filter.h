@@ -0,0 +1,156 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ * This file stores headers for ADC filter pipeline. Every sample goes
+ * through median, oversampling, moving average and IIR stages, each of
+ * them can be turned off. All stages use 16 bit integers and shifts only,
+ * so pipeline is cheap enough to run in ADC interrupt.
+ */
+
+#include "../../settings.h"
+#include "../../kernel/types.h"
+#include "adc.h"
+
+#ifndef DRIVERS_INTEGRATED_ADC_FILTER_H_INCLUDED
+#define DRIVERS_INTEGRATED_ADC_FILTER_H_INCLUDED
+
+#ifdef USE_ADC_FILTER
+
+/** \def ADC_FILTER_MEDIAN_MAX
+ * Most samples in median stage.
+ */
+#define ADC_FILTER_MEDIAN_MAX 5
+
+/** \def ADC_FILTER_SHIFT_MAX
+ * Biggest shift of oversampling, moving average and IIR stages. With 10
+ * bit samples, all sums fit in 16 bits.
+ */
+#define ADC_FILTER_SHIFT_MAX 3
+
+/** \struct adc_filter_t
+ * This struct stores settings and state of filter pipeline of one channel.
+ */
+typedef struct {
+
+    /* Count of samples in median, 0 or 1 turns stage off, up to 5 */
+    uint8_t median_size;
+
+    /* Count of extra bits, 4 to power of it samples give one value */
+    uint8_t oversample_shift;
+
+    /* Window of moving average has 2 to power of it values */
+    uint8_t average_shift;
+
+    /* IIR takes 1 / 2 to power of it of every new value */
+    uint8_t iir_shift;
+
+    /* Last samples for median */
+    adc_result_t median[ADC_FILTER_MEDIAN_MAX];
+
+    /* Position of next sample for median, and count of samples in it */
+    uint8_t median_position;
+    uint8_t median_count;
+
+    /* Sum and count of samples for oversampling */
+    uint16_t oversample_sum;
+    uint8_t oversample_count;
+
+    /* Last values for moving average, and their sum */
+    adc_result_t average[1 << ADC_FILTER_SHIFT_MAX];
+    uint16_t average_sum;
+
+    /* Position of next value for moving average, and count of values */
+    uint8_t average_position;
+    uint8_t average_count;
+
+    /* IIR output multiplied by 2 to power of iir_shift */
+    uint16_t iir_state;
+
+    /* Filtered value */
+    adc_result_t value;
+
+    /* No value went through pipeline yet */
+    bool empty;
+
+} adc_filter_t;
+
+/** \fn limit_adc_filter_setting
+ * This function returns given setting, or max when setting is bigger.
+ * @setting Setting of filter stage
+ * @max Biggest allowed setting
+ */
+static inline uint8_t limit_adc_filter_setting(uint8_t setting, uint8_t max) {
+    return setting > max ? max : setting;
+}
+
+/** \fn create_adc_filter
+ * This function creates filter pipeline with given settings. Shift 0 turns
+ * stage off. Settings bigger than ADC_FILTER_MEDIAN_MAX and
+ * ADC_FILTER_SHIFT_MAX are limited to them, so state is never overrun.
+ * @median_size Count of samples in median, 0 or 1 turns it off, up to 5
+ * @oversample_shift Count of extra bits from oversampling
+ * @average_shift Window of moving average has 2 to power of it values
+ * @iir_shift IIR takes 1 / 2 to power of it of every new value
+ */
+static inline adc_filter_t create_adc_filter(
+    uint8_t median_size,
+    uint8_t oversample_shift,
+    uint8_t average_shift,
+    uint8_t iir_shift
+) {
+    return (adc_filter_t) {
+        .median_size = limit_adc_filter_setting(
+            median_size,
+            ADC_FILTER_MEDIAN_MAX
+        ),
+        .oversample_shift = limit_adc_filter_setting(
+            oversample_shift,
+            ADC_FILTER_SHIFT_MAX
+        ),
+        .average_shift = limit_adc_filter_setting(
+            average_shift,
+            ADC_FILTER_SHIFT_MAX
+        ),
+        .iir_shift = limit_adc_filter_setting(
+            iir_shift,
+            ADC_FILTER_SHIFT_MAX
+        ),
+        .empty = true
+    };
+}
+
+/** \fn filter_adc_sample
+ * This function puts sample into pipeline. Return true when new filtered
+ * value is ready, with oversampling it is once per 4 to power of
+ * oversample_shift samples.
+ * @*filter Filter pipeline
+ * @sample Raw sample from ADC
+ */
+bool filter_adc_sample(adc_filter_t *filter, adc_result_t sample);
+
+/** \fn get_adc_filter_value
+ * This function returns last filtered value, it has oversample_shift more
+ * bits than raw sample.
+ * @*filter Filter pipeline
+ */
+static inline adc_result_t get_adc_filter_value(adc_filter_t *filter) {
+    return filter->value;
+}
+
+/** \fn reset_adc_filter
+ * This function clears state of pipeline, settings are not changed.
+ * @*filter Filter pipeline
+ */
+void reset_adc_filter(adc_filter_t *filter);
+
+#endif
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ * This file stores headers for ADC scan sequencer. It converts list of
+ * channels one by one from ADC interrupt, stores latest value of every
+ * channel, and puts every whole scan with its time into ring of frames.
+ */
+
+#include "../../settings.h"
+#include "../../kernel/types.h"
+#include "../../kernel/time.h"
+#include "../../platforms/avr.h"
+#include "adc.h"
+#include "adc_filter.h"
+
+#ifndef DRIVERS_INTEGRATED_ADC_SCAN_H_INCLUDED
+#define DRIVERS_INTEGRATED_ADC_SCAN_H_INCLUDED
+
+#ifdef USE_AVR_ADC_SCAN
+
+/** \def ADC_SCAN_MAX_CHANNELS
+ * Most channels in one scan.
+ */
+#ifndef ADC_SCAN_MAX_CHANNELS
+#define ADC_SCAN_MAX_CHANNELS 6
+#endif
+
+/** \def ADC_SCAN_FRAMES
+ * Count of scan frames waiting for reader, it must be power of two.
+ */
+#ifndef ADC_SCAN_FRAMES
+#define ADC_SCAN_FRAMES 4
+#endif
+
+/** \def ADC_SCAN_SIGNAL
+ * Signal made after every whole scan.
+ */
+#define ADC_SCAN_SIGNAL 0x41
+
+/** \def ADC_SCAN_FREE_RUNNING
+ * Period for start_adc_scan, next scan starts right after previous one.
+ */
+#define ADC_SCAN_FREE_RUNNING 0x0000
+
+/** \struct adc_scan_frame_t
+ * This struct stores results of one whole scan.
+ */
+typedef struct {
+
+    /* System time when scan started */
+    system_tick_t time;
+
+    /* Results, in order of channels given to start_adc_scan */
+    adc_result_t values[ADC_SCAN_MAX_CHANNELS];
+
+} adc_scan_frame_t;
+
+/** \fn start_adc_scan
+ * This function starts scanning of given channels. With period, scan is
+ * started by timer every period system ticks, else with
+ * ADC_SCAN_FREE_RUNNING next scan starts right after previous one. Return
+ * false when ADC is busy or there are too many channels.
+ * @*channels Muxes to convert, must be valid while scanning
+ * @count Count of channels
+ * @period System ticks between scans, or ADC_SCAN_FREE_RUNNING
+ */
+bool start_adc_scan(
+    const adc_mux_t *channels,
+    uint8_t count,
+    system_tick_t period
+);
+
+#ifdef USE_ADC_FILTER
+
+/** \fn set_adc_scan_filters
+ * This function sets filter pipelines for scanned channels, one for every
+ * channel, in order of channels. Latest values and frames store filtered
+ * values, with oversampling value changes once per many scans. Call it
+ * before start_adc_scan, or with nullptr to turn filters off.
+ * @*filters Filter pipelines, must be valid while scanning
+ */
+void set_adc_scan_filters(adc_filter_t *filters);
+
+#endif
+
+/** \fn stop_adc_scan
+ * This function stops scanning, scan that is running now is finished.
+ */
+void stop_adc_scan(void);
+
+/** \fn is_adc_scan_active
+ * This function returns true while scanning, or while last scan after
+ * stop_adc_scan is not finished.
+ */
+bool is_adc_scan_active(void);
+
+/** \fn get_adc_scan_value
+ * This function returns latest result of given channel.
+ * @channel Position of channel in list given to start_adc_scan
+ */
+adc_result_t get_adc_scan_value(uint8_t channel);
+
+/** \fn get_adc_scan_frame
+ * This function returns oldest scan frame that is not released, or nullptr.
+ * Frame does not change until release_adc_scan_frame.
+ */
+const adc_scan_frame_t *get_adc_scan_frame(void);
+
+/** \fn release_adc_scan_frame
+ * This function releases frame returned by get_adc_scan_frame, so it can
+ * be used for next scan.
+ */
+void release_adc_scan_frame(void);
+
+/** \fn get_adc_scan_overruns
+ * This function returns count of scans lost, because all frames were not
+ * released.
+ */
+uint8_t get_adc_scan_overruns(void);
+
+/** \fn complete_adc_scan_conversion
+ * A function that should only be called by ADC interrupt, it stores result
+ * of conversion and starts next one.
+ * @result Result of conversion
+ */
+void complete_adc_scan_conversion(adc_result_t result);
+
+#endif
+
+#endif
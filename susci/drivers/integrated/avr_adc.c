@@ -19,9 +19,40 @@
 #ifdef USE_AVR_ADC
 
 #include <avr/io.h>
+#include <avr/interrupt.h>
 
 #include "adc.h"
+#include "adc_scan.h"
 #include "../../kernel/types.h"
+#include "../../kernel/interface.h"
+
+/** \var adc_result
+ * Result of last conversion started by start_adc_conversion.
+ */
+static volatile adc_result_t adc_result;
+
+/** \var adc_ready
+ * Result is ready and not taken yet.
+ */
+static volatile bool adc_ready;
+
+/** \var adc_busy
+ * Conversion started by start_adc_conversion is running.
+ */
+static volatile bool adc_busy;
+
+/** \var adc_quiet
+ * Quiet conversion waits for sleep in ADC noise reduction mode.
+ */
+static volatile bool adc_quiet;
+
+/** \fn select_adc_mux
+ * This function selects given mux, reference and adjust are not changed.
+ * @adc_mux Mux to select
+ */
+static inline void select_adc_mux(adc_mux_t adc_mux) {
+    ADMUX = (ADMUX & 0xE0) | adc_mux;
+}
 
 /** \fn setup_adc_reference
  * This setup voltage reference for ADC.
@@ -38,25 +69,142 @@ void setup_adc_reference(adc_mux_t adc_reference) {
 }
 
 /** \fn read_from_adc
- * This function return data readed from adc on mux given in parameter.
+ * This function return data readed from adc on mux given in parameter. It
+ * waits for end of conversion, so use start_adc_conversion when You can.
+ * While other conversion or scan is running, it does not touch ADC and
+ * returns ADC_BUSY_RESULT at once.
  * @adc_pin Mux to read from
  */
 adc_result_t read_from_adc(adc_mux_t adc_mux) {
-    /*
-     * Set ADMUX, read data and return it.
-     */
+    if (is_adc_busy()) return ADC_BUSY_RESULT;
+
+    select_adc_mux(adc_mux);
+
+    /* Prescaler set by setup_adc_reference must stay */
+    ADCSRA = (ADCSRA & ~(1 << ADIE)) | (1 << ADEN) | (1 << ADSC);
+
+    while (ADCSRA & (1 << ADSC)) ;
+
+    return (adc_result_t) (ADC);
+}
+
+/** \fn start_adc_conversion
+ * This function starts conversion on given mux and returns at once. When
+ * conversion is complete, interrupt stores result and makes
+ * ADC_COMPLETE_SIGNAL. Return false when other conversion is running.
+ * @adc_mux Mux to read from
+ */
+bool start_adc_conversion(adc_mux_t adc_mux) {
+    if (is_adc_busy()) return false;
+
+    adc_busy = true;
+    adc_ready = false;
+
+    select_adc_mux(adc_mux);
+
+    ADCSRA |= (1 << ADEN) | (1 << ADIE) | (1 << ADSC);
+
+    return true;
+}
+
+/** \fn start_quiet_adc_conversion
+ * This function prepares conversion on given mux, that is started when no
+ * process has any work, and CPU sleeps in ADC noise reduction mode during
+ * it. Without USE_ADC_NOISE_SLEEP it is started at once, as by
+ * start_adc_conversion. When conversion is complete, interrupt stores
+ * result and makes ADC_COMPLETE_SIGNAL. Return false when other conversion
+ * is running.
+ * @adc_mux Mux to read from
+ */
+bool start_quiet_adc_conversion(adc_mux_t adc_mux) {
+    if (is_adc_busy()) return false;
+
+#ifdef USE_AVR_ADC_NOISE_SLEEP
+    adc_busy = true;
+    adc_ready = false;
+    adc_quiet = true;
+
+    select_adc_mux(adc_mux);
 
-     ADMUX &= 0xE0;
-     ADMUX |= adc_mux;
+    /* Conversion is started by entering sleep, not by ADSC */
+    ADCSRA |= (1 << ADEN) | (1 << ADIE);
+
+    return true;
+#else
+    return start_adc_conversion(adc_mux);
+#endif
+}
+
+/** \fn begin_quiet_adc_sleep
+ * A function that should only be called by platform_idle with interrupts
+ * disabled. Return true when quiet conversion waits and sleep can start
+ * it, then it is marked as started. When it waits but CPU can not sleep,
+ * it is started at once, so it never waits forever.
+ * @can_sleep CPU can sleep in ADC noise reduction mode now
+ */
+bool begin_quiet_adc_sleep(bool can_sleep) {
+    if (!adc_quiet) return false;
+
+    adc_quiet = false;
+
+    if (!can_sleep) {
+        ADCSRA |= (1 << ADSC);
+
+        return false;
+    }
+
+    return true;
+}
+
+/** \fn is_adc_busy
+ * This function returns true while conversion is running.
+ */
+bool is_adc_busy(void) {
+#ifdef USE_AVR_ADC_SCAN
+    if (is_adc_scan_active()) return true;
+#endif
+
+    return (bool) (adc_busy || (ADCSRA & (1 << ADSC)));
+}
+
+/** \fn is_adc_ready
+ * This function returns true when result of conversion started by
+ * start_adc_conversion is ready and not taken yet.
+ */
+bool is_adc_ready(void) {
+    return adc_ready;
+}
+
+/** \fn get_adc_result
+ * This function returns result of last conversion started by
+ * start_adc_conversion, and marks it taken.
+ */
+adc_result_t get_adc_result(void) {
+    adc_ready = false;
+
+    return adc_result;
+}
+
+/** \fn ISR
+ * This stores result of complete conversion, and wakes up process waiting
+ * for it, or passes it to scan sequencer.
+ */
+ISR(ADC_vect) {
+#ifdef USE_AVR_ADC_SCAN
+    if (is_adc_scan_active()) {
+        complete_adc_scan_conversion((adc_result_t) (ADC));
+
+        return;
+    }
+#endif
 
-     ADCSRA = (
-        (1 << ADEN) |
-        (1 << ADSC)
-     );
+    adc_result = (adc_result_t) (ADC);
+    adc_busy = false;
+    adc_ready = true;
 
-     while (ADCSRA & (1 << ADSC)) ;
+    ADCSRA &= ~(1 << ADIE);
 
-     return (adc_result_t) (ADC);
+    make_signal(ADC_COMPLETE_SIGNAL);
 }
 
 #endif
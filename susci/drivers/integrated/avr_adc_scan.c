@@ -0,0 +1,319 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ * This file stores code for ADC scan sequencer. It converts list of
+ * channels one by one from ADC interrupt, stores latest value of every
+ * channel, and puts every whole scan with its time into ring of frames.
+ */
+
+#include "../../settings.h"
+#include "../../platforms/avr.h"
+
+#ifdef USE_AVR_ADC_SCAN
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "adc.h"
+#include "adc_scan.h"
+#include "adc_filter.h"
+#include "../../kernel/types.h"
+#include "../../kernel/time.h"
+#include "../../kernel/platform.h"
+#include "../../kernel/interface.h"
+
+/** \var adc_scan_channels
+ * Muxes to convert in every scan.
+ */
+static const adc_mux_t *adc_scan_channels;
+
+/** \var adc_scan_count
+ * Count of channels in every scan.
+ */
+static uint8_t adc_scan_count;
+
+/** \var adc_scan_channel
+ * Position of channel that is converting now.
+ */
+static volatile uint8_t adc_scan_channel;
+
+/** \var adc_scan_period
+ * System ticks between scans, or ADC_SCAN_FREE_RUNNING.
+ */
+static system_tick_t adc_scan_period;
+
+/** \var adc_scan_running
+ * Scanning is started, and not stopped.
+ */
+static volatile bool adc_scan_running;
+
+/** \var adc_scan_sweeping
+ * Scan is converting now.
+ */
+static volatile bool adc_scan_sweeping;
+
+/** \var adc_scan_time
+ * System time when scan that is converting now started.
+ */
+static volatile system_tick_t adc_scan_time;
+
+/** \var adc_scan_values
+ * Latest result of every channel.
+ */
+static volatile adc_result_t adc_scan_values[ADC_SCAN_MAX_CHANNELS];
+
+#ifdef USE_ADC_FILTER
+/** \var adc_scan_filters
+ * Filter pipeline of every channel, or nullptr.
+ */
+static adc_filter_t *adc_scan_filters;
+#endif
+
+/** \var adc_scan_frames
+ * Ring of whole scans, written by interrupt and read by processes.
+ */
+static adc_scan_frame_t adc_scan_frames[ADC_SCAN_FRAMES];
+
+/** \var adc_scan_write
+ * Position of next frame to write, changed only by interrupt.
+ */
+static volatile uint8_t adc_scan_write;
+
+/** \var adc_scan_read
+ * Position of oldest frame, changed only by processes.
+ */
+static volatile uint8_t adc_scan_read;
+
+/** \var adc_scan_overruns
+ * Count of scans lost, because all frames were not released.
+ */
+static volatile uint8_t adc_scan_overruns;
+
+/** \fn begin_adc_scan_sweep
+ * This function starts converting first channel of new scan.
+ */
+static inline void begin_adc_scan_sweep(void) {
+    adc_scan_sweeping = true;
+    adc_scan_time = get_time();
+    adc_scan_channel = 0x00;
+
+    ADMUX = (ADMUX & 0xE0) | adc_scan_channels[0];
+    ADCSRA |= (1 << ADEN) | (1 << ADIE) | (1 << ADSC);
+}
+
+/** \fn store_adc_scan_frame
+ * This function puts latest results of all channels into ring of frames,
+ * or counts overrun when ring is full.
+ */
+static inline void store_adc_scan_frame(void) {
+    uint8_t position = adc_scan_write;
+
+    if ((uint8_t) (position - adc_scan_read) >= ADC_SCAN_FRAMES) {
+        if (adc_scan_overruns != 0xFF) ++ adc_scan_overruns;
+
+        return;
+    }
+
+    adc_scan_frame_t *frame = &adc_scan_frames[
+        position & (ADC_SCAN_FRAMES - 1)
+    ];
+
+    frame->time = adc_scan_time;
+
+    for (uint8_t channel = 0; channel < adc_scan_count; ++ channel) {
+        frame->values[channel] = adc_scan_values[channel];
+    }
+
+    /* Frame must be whole before reader can see it */
+    compiler_barrier();
+    adc_scan_write = position + 1;
+}
+
+/** \fn complete_adc_scan_conversion
+ * A function that should only be called by ADC interrupt, it stores result
+ * of conversion and starts next one.
+ * @result Result of conversion
+ */
+void complete_adc_scan_conversion(adc_result_t result) {
+    uint8_t channel = adc_scan_channel;
+
+#ifdef USE_ADC_FILTER
+    if (adc_scan_filters == nullptr) {
+        adc_scan_values[channel] = result;
+    } else if (filter_adc_sample(&adc_scan_filters[channel], result)) {
+        adc_scan_values[channel] = get_adc_filter_value(
+            &adc_scan_filters[channel]
+        );
+    }
+#else
+    adc_scan_values[channel] = result;
+#endif
+
+    if (++ channel < adc_scan_count) {
+        adc_scan_channel = channel;
+
+        ADMUX = (ADMUX & 0xE0) | adc_scan_channels[channel];
+        ADCSRA |= (1 << ADSC);
+
+        return;
+    }
+
+    store_adc_scan_frame();
+    make_signal(ADC_SCAN_SIGNAL);
+
+    if (adc_scan_running && adc_scan_period == ADC_SCAN_FREE_RUNNING) {
+        begin_adc_scan_sweep();
+
+        return;
+    }
+
+    adc_scan_sweeping = false;
+    ADCSRA &= ~(1 << ADIE);
+}
+
+/** \fn ISR
+ * This starts new scan every period, when previous one is finished, else
+ * scan is lost and counted as overrun.
+ */
+ISR(ADC_SCAN_vect) {
+    ADC_SCAN_COMPARE += adc_scan_period;
+
+    if (!adc_scan_running) return;
+
+    if (adc_scan_sweeping) {
+        if (adc_scan_overruns != 0xFF) ++ adc_scan_overruns;
+
+        return;
+    }
+
+    begin_adc_scan_sweep();
+}
+
+/** \fn start_adc_scan
+ * This function starts scanning of given channels. With period, scan is
+ * started by timer every period system ticks, else with
+ * ADC_SCAN_FREE_RUNNING next scan starts right after previous one. Return
+ * false when ADC is busy or there are too many channels.
+ * @*channels Muxes to convert, must be valid while scanning
+ * @count Count of channels
+ * @period System ticks between scans, or ADC_SCAN_FREE_RUNNING
+ */
+bool start_adc_scan(
+    const adc_mux_t *channels,
+    uint8_t count,
+    system_tick_t period
+) {
+    if (count == 0x00 || count > ADC_SCAN_MAX_CHANNELS) return false;
+    if (is_adc_busy()) return false;
+
+    adc_scan_channels = channels;
+    adc_scan_count = count;
+    adc_scan_period = period;
+    adc_scan_running = true;
+
+    uint8_t state = platform_lock();
+
+    if (period == ADC_SCAN_FREE_RUNNING) {
+        begin_adc_scan_sweep();
+    } else {
+        ADC_SCAN_COMPARE = (system_tick_t) (get_time() + period);
+        ADC_SCAN_FLAGS = (1 << ADC_SCAN_FLAG);
+        ADC_SCAN_MASK |= (1 << ADC_SCAN_ENABLE);
+    }
+
+    platform_unlock(state);
+
+    return true;
+}
+
+#ifdef USE_ADC_FILTER
+/** \fn set_adc_scan_filters
+ * This function sets filter pipelines for scanned channels, one for every
+ * channel, in order of channels. Latest values and frames store filtered
+ * values, with oversampling value changes once per many scans. Call it
+ * before start_adc_scan, or with nullptr to turn filters off.
+ * @*filters Filter pipelines, must be valid while scanning
+ */
+void set_adc_scan_filters(adc_filter_t *filters) {
+    adc_scan_filters = filters;
+}
+#endif
+
+/** \fn stop_adc_scan
+ * This function stops scanning, scan that is running now is finished.
+ */
+void stop_adc_scan(void) {
+    /* Timer mask is shared with uart idle interrupt */
+    uint8_t state = platform_lock();
+
+    adc_scan_running = false;
+    ADC_SCAN_MASK &= ~(1 << ADC_SCAN_ENABLE);
+
+    platform_unlock(state);
+}
+
+/** \fn is_adc_scan_active
+ * This function returns true while scanning, or while last scan after
+ * stop_adc_scan is not finished.
+ */
+bool is_adc_scan_active(void) {
+    return (bool) (adc_scan_running || adc_scan_sweeping);
+}
+
+/** \fn get_adc_scan_value
+ * This function returns latest result of given channel.
+ * @channel Position of channel in list given to start_adc_scan
+ */
+adc_result_t get_adc_scan_value(uint8_t channel) {
+    /* Result has two bytes, interrupt can change it between them */
+    uint8_t state = platform_lock();
+    adc_result_t value = adc_scan_values[channel];
+    platform_unlock(state);
+
+    return value;
+}
+
+/** \fn get_adc_scan_frame
+ * This function returns oldest scan frame that is not released, or nullptr.
+ * Frame does not change until release_adc_scan_frame.
+ */
+const adc_scan_frame_t *get_adc_scan_frame(void) {
+    uint8_t position = adc_scan_read;
+
+    if (position == adc_scan_write) return nullptr;
+
+    /* Frame must not be read before it was seen written */
+    compiler_barrier();
+
+    return &adc_scan_frames[position & (ADC_SCAN_FRAMES - 1)];
+}
+
+/** \fn release_adc_scan_frame
+ * This function releases frame returned by get_adc_scan_frame, so it can
+ * be used for next scan.
+ */
+void release_adc_scan_frame(void) {
+    if (adc_scan_read == adc_scan_write) return;
+
+    /* Reader must end with frame before writer can use it */
+    compiler_barrier();
+    ++ adc_scan_read;
+}
+
+/** \fn get_adc_scan_overruns
+ * This function returns count of scans lost, because all frames were not
+ * released.
+ */
+uint8_t get_adc_scan_overruns(void) {
+    return adc_scan_overruns;
+}
+
+#endif
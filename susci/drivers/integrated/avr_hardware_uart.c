@@ -18,45 +18,310 @@
 #include "../../kernel/types.h"
 #include "../../kernel/process.h"
 #include "../../kernel/scheduler.h"
-#include "../../synchronization/buffer.h"
+#include "../../kernel/interface.h"
+#include "../../kernel/platform.h"
+#include "../../synchronization/ring_buffer.h"
+#include "../../synchronization/shared_memory.h"
 #include "hardware_uart.h"
 
 #ifdef USE_AVR_HARDWARE_UART
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 
-buffer_t hardware_uart_sender;
-buffer_t hardware_uart_receiver;
+DECLARE_RING_BUFFER(hardware_uart_sender, char, UART_TX_SIZE);
+DECLARE_RING_BUFFER(hardware_uart_receiver, char, UART_RX_SIZE);
 
-/** \fn hardware_uart_sender_service
- * This is service for hardware uart. If any data is in buffer, it send one
- * char from it to uart device. It use hardware_uart_sender aka print_buffer
- * that is global var, you must set nullptr as param for this process.
+/** \var hardware_uart_dropped
+ * Count of received chars, that was lost because receive buffer was full.
  */
-exec_state_t hardware_uart_sender_service(void *param) {
-	if (!is_buffer_readable(&hardware_uart_sender)) return IDLE_STATE;
+volatile uint8_t hardware_uart_dropped;
 
-	while (!(UCSRA & (1 << UDRE)));
+/** \var hardware_uart_transmitted
+ * Any char has been written to data register, so transmit complete flag
+ * tells when transmitter is idle.
+ */
+static volatile bool hardware_uart_transmitted;
+
+#if UART_RX_IDLE_CHARS
+/** \var hardware_uart_idle_ticks
+ * Count of system ticks of UART_RX_IDLE_CHARS at current speed.
+ */
+static uint16_t hardware_uart_idle_ticks;
+#endif
+
+/** \var hardware_uart_queue
+ * Transfers waiting for sending, first is sending now.
+ */
+static uart_transfer_t *volatile hardware_uart_queue[UART_QUEUE_SIZE];
+
+/** \var hardware_uart_queue_write
+ * Position of next transfer put into queue, changed only by processes.
+ */
+static volatile uint8_t hardware_uart_queue_write;
+
+/** \var hardware_uart_queue_read
+ * Position of transfer sending now, changed only by interrupt.
+ */
+static volatile uint8_t hardware_uart_queue_read;
+
+/** \fn start_hardware_uart
+ * This function enables data register empty interrupt, that sends data
+ * from transmit buffer until it is empty. Interrupt only disables itself
+ * when buffer is empty, so it is safe to set it after data was written.
+ * Call it after writing directly to hardware_uart_sender.
+ */
+void start_hardware_uart(void) {
+    UCSRB |= (1 << UDRIE);
+}
+
+/** \fn write_hardware_uart
+ * This function puts char into transmit buffer, and starts sending it by
+ * interrupt. Return false when buffer is full, and char is not sent.
+ * @data Char to send
+ */
+bool write_hardware_uart(char data) {
+    if (!write_ring_buffer(&hardware_uart_sender, data)) return false;
+
+    start_hardware_uart();
+
+    return true;
+}
+
+/** \fn write_hardware_uart_span
+ * This function puts as many of given chars as fit into transmit buffer,
+ * and starts sending them by interrupt. Return count of chars put.
+ * @*data Chars to send
+ * @length Count of chars
+ */
+uint8_t write_hardware_uart_span(const char *data, uint8_t length) {
+    uint8_t written = write_ring_buffer_span(
+        &hardware_uart_sender,
+        data,
+        length
+    );
+
+    if (written) start_hardware_uart();
 
-	UDR = read_buffer(&hardware_uart_sender);
+    return written;
+}
+
+/** \fn send_hardware_uart_transfer
+ * This function puts transfer into queue, and starts sending it by
+ * interrupt. Return false when queue is full. Data is sent in order it was
+ * given, chars written to transmit buffer before transfer are sent before
+ * it, and chars written after it are sent after its end.
+ * @*transfer Transfer to send
+ */
+bool send_hardware_uart_transfer(uart_transfer_t *transfer) {
+    uint8_t position = hardware_uart_queue_write;
+
+    if ((uint8_t) (position - hardware_uart_queue_read) >= UART_QUEUE_SIZE) {
+        return false;
+    }
+
+    if (transfer->length == 0x00) {
+        if (transfer->signal != 0x00) make_signal(transfer->signal);
+
+        return true;
+    }
 
-	return GOOD_STATE;
+    transfer->mark = hardware_uart_sender.write_position;
+    hardware_uart_queue[position & (UART_QUEUE_SIZE - 1)] = transfer;
+
+    /* Transfer must be in queue before interrupt can see it */
+    compiler_barrier();
+    hardware_uart_queue_write = position + 1;
+
+    start_hardware_uart();
+
+    return true;
+}
+
+/** \fn read_uart_transfer
+ * This function returns next char of transfer, and ends transfer when it
+ * was last one.
+ * @*transfer Transfer that is sending
+ */
+static inline char read_uart_transfer(uart_transfer_t *transfer) {
+    char data;
+
+    switch (transfer->source) {
+        case UART_SOURCE_FLASH:
+            data = (char) pgm_read_byte(transfer->data++);
+        break;
+
+        case UART_SOURCE_SHARED:
+            data = read_shared_memory_area(
+                transfer->shared,
+                transfer->address++
+            );
+        break;
+
+        default:
+            data = *transfer->data++;
+        break;
+    }
+
+    if (-- transfer->length == 0x00) {
+        ++ hardware_uart_queue_read;
+
+        if (transfer->signal != 0x00) make_signal(transfer->signal);
+    }
+
+    return data;
+}
+
+/** \fn send_hardware_uart_char
+ * This function writes char to data register, and clears transmit
+ * complete flag, that is set again when char is shifted out.
+ * @data Char to send
+ */
+static inline void send_hardware_uart_char(char data) {
+    UDR = data;
+    UCSRA = (UCSRA & ((1 << U2X) | (1 << MPCM))) | (1 << TXC);
+
+    hardware_uart_transmitted = true;
 }
 
 /** \fn ISR
- * This is responsible for inserting new received data to buffer.
+ * This sends next char from transmit buffer, until mark of first transfer
+ * in queue, then whole transfer, or disables itself when everything is
+ * sent. So chars of transmit buffer never come inside transfer. Processes
+ * are signaled only on low watermark, end of transfer and when all data
+ * has been sent, not for every char.
+ */
+ISR(USART_UDRE_vect) {
+    uart_transfer_t *transfer = nullptr;
+
+    if (hardware_uart_queue_read != hardware_uart_queue_write) {
+        transfer = hardware_uart_queue[
+            hardware_uart_queue_read & (UART_QUEUE_SIZE - 1)
+        ];
+    }
+
+    if (
+        !is_ring_buffer_empty(&hardware_uart_sender)
+        && (
+            transfer == nullptr
+            || hardware_uart_sender.read_position != transfer->mark
+        )
+    ) {
+        send_hardware_uart_char(read_ring_buffer(&hardware_uart_sender));
+
+        if (
+            get_ring_buffer_count(&hardware_uart_sender)
+            == UART_TX_LOW_WATERMARK
+        ) {
+            make_signal(HARDWARE_UART_LOW_SIGNAL);
+        }
+
+        return;
+    }
+
+    if (transfer != nullptr) {
+        send_hardware_uart_char(read_uart_transfer(transfer));
+
+        return;
+    }
+
+    UCSRB &= ~(1 << UDRIE);
+    make_signal(HARDWARE_UART_SENT_SIGNAL);
+}
+
+/** \fn hardware_uart_arm_idle
+ * This function starts counting idle time of line from now, compare
+ * interrupt comes when no char comes for hardware_uart_idle_ticks.
+ */
+static inline void hardware_uart_arm_idle(void) {
+#if UART_RX_IDLE_CHARS
+    UART_IDLE_COMPARE = (uint16_t) (get_time() + hardware_uart_idle_ticks);
+    UART_IDLE_FLAGS = (1 << UART_IDLE_FLAG);
+    UART_IDLE_MASK |= (1 << UART_IDLE_ENABLE);
+#endif
+}
+
+/** \fn hardware_uart_disarm_idle
+ * This function stops counting idle time of line.
+ */
+static inline void hardware_uart_disarm_idle(void) {
+#if UART_RX_IDLE_CHARS
+    UART_IDLE_MASK &= ~(1 << UART_IDLE_ENABLE);
+#endif
+}
+
+/** \fn ISR
+ * This is responsible for inserting new received data to buffer. Receiver
+ * is woken up only when threshold or delimiter is reached, else idle time
+ * of line starts counting again.
  */
 ISR(USART_RXC_vect) {
-    write_buffer(&hardware_uart_receiver, UDR);
+    char data = UDR;
+
+    if (!write_ring_buffer(&hardware_uart_receiver, data)) {
+        if (hardware_uart_dropped != 0xFF) ++ hardware_uart_dropped;
+    }
+
+    bool wake_up = (bool) (
+        get_ring_buffer_count(&hardware_uart_receiver) == UART_RX_THRESHOLD
+    );
+
+#ifdef UART_RX_DELIMITER
+    if ((uint8_t) data == (uint8_t) UART_RX_DELIMITER) wake_up = true;
+#endif
+
+    if (wake_up) {
+        hardware_uart_disarm_idle();
+        make_signal(HARDWARE_UART_RECEIVED_SIGNAL);
+    } else {
+        hardware_uart_arm_idle();
+    }
+}
+
+#if UART_RX_IDLE_CHARS
+/** \fn ISR
+ * This comes when line is idle for UART_RX_IDLE_CHARS, it wakes up
+ * receiver, when any data is waiting in buffer.
+ */
+ISR(UART_IDLE_vect) {
+    hardware_uart_disarm_idle();
+
+    if (!is_ring_buffer_empty(&hardware_uart_receiver)) {
+        make_signal(HARDWARE_UART_RECEIVED_SIGNAL);
+    }
+}
+#endif
+
+/** \fn is_hardware_uart_idle
+ * This function returns true when every char has been shifted out, no
+ * received char waits in data register, and no message is being received,
+ * so line is idle for UART_RX_IDLE_CHARS. Char that starts while clock of
+ * uart is stopped is still lost.
+ */
+bool is_hardware_uart_idle(void) {
+    if (UCSRB & (1 << UDRIE)) return false;
+    if (UCSRA & (1 << RXC)) return false;
+
+#if UART_RX_IDLE_CHARS
+    if (UART_IDLE_MASK & (1 << UART_IDLE_ENABLE)) return false;
+#endif
+
+    return (bool) (!hardware_uart_transmitted || (UCSRA & (1 << TXC)));
 }
 
 /** \fn enable_hardware_uart
- * This function setup uart device to work in system. This create new process
- * in system for uart_sender and turn on interrupts.
+ * This function setup uart device to work in system, and turn on interrupts.
  * @speed uart buadrate
  */
 void enable_hardware_uart(long speed) {
+#if UART_RX_IDLE_CHARS
+    /* Char is 10 bits, tick is 1024 cycles, one more tick for its part */
+    hardware_uart_idle_ticks = (uint16_t) (
+        (UART_RX_IDLE_CHARS * 10L * (F_CPU / 1024) + speed - 1) / speed + 1
+    );
+#endif
+
     speed = ((F_CPU / (speed * 16UL)) - 1);
 
     UBRRH = (uint8_t) (speed >> 8);
@@ -65,11 +330,6 @@ void enable_hardware_uart(long speed) {
     UCSRB = (1 << RXCIE) | (1 << RXEN) | (1 << TXEN);
     UCSRC = (1 << URSEL) | (1 << UCSZ0) | (1 << UCSZ1);
 
-    hardware_uart_receiver = create_buffer();
-    hardware_uart_sender = create_buffer();
-
-    create_process(get_first_empty(), hardware_uart_sender_service, nullptr);
-
     sei();
 }
 
@@ -17,24 +17,125 @@
 #include "../../platforms/avr.h"
 #include "../../kernel/types.h"
 #include "../../kernel/interface.h"
+#include "../../kernel/platform.h"
 #include "pinchange.h"
+#include "avr_pins.h"
 
 #ifdef USE_AVR_PINCHANGE
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
 
+/** \var pinchange_snapshot
+ * State of all ports after last pinchange interrupt.
+ */
+static uint8_t pinchange_snapshot[PORTS_COUNT];
+
+/** \var pinchange_rising
+ * Pins of every port with rising edge, that is not taken yet.
+ */
+static volatile uint8_t pinchange_rising[PORTS_COUNT];
+
+/** \var pinchange_falling
+ * Pins of every port with falling edge, that is not taken yet.
+ */
+static volatile uint8_t pinchange_falling[PORTS_COUNT];
+
+/** \fn handle_pinchange
+ * This compares all ports with snapshot, stores edges of pins with enabled
+ * pinchange, and makes signal of changed pin, or PINCHANGE_SIGNAL.
+ */
+static inline void handle_pinchange(void) {
+    uint8_t changed[PORTS_COUNT];
+
+    for (uint8_t port = 0; port < PORTS_COUNT; ++ port) {
+        uint8_t state = *create_port_input_pointer(port);
+
+        changed[port] = (state ^ pinchange_snapshot[port]) & LOW_PCMSK[port];
+        pinchange_snapshot[port] = state;
+
+        pinchange_rising[port] |= changed[port] & state;
+        pinchange_falling[port] |= changed[port] & ~state;
+    }
+
+    bool routed = false;
+
+#ifdef PINCHANGE_ROUTES
+#define PINCHANGE_ROUTE(pin, signal) \
+    if (changed[(pin) / 8] & _BV((pin) % 8)) { \
+        make_signal(signal); \
+        routed = true; \
+    }
+
+    PINCHANGE_ROUTES
+
+#undef PINCHANGE_ROUTE
+#endif
+
+    if (!routed) make_signal(PINCHANGE_SIGNAL);
+}
+
 /** \fn setup_pinchange_on_pin
  * This function enable pinchange on specified pin.
  * @pin_number Number of pin
  */
 void setup_pinchange_on_pin(pin_t pin_number) {
-    volatile uint8_t *pcmask = LOW_PCMSK + (
-		((uint8_t) (pin_number)) / 8
-	);
+    uint8_t port = ((uint8_t) (pin_number)) / 8;
     uint8_t mask = _BV (pin_number % 8);
 
-    *pcmask |= mask;
+    /* Snapshot and mask must change at once, before next interrupt */
+    uint8_t state = platform_lock();
+
+    pinchange_snapshot[port] = *create_port_input_pointer(port);
+    LOW_PCMSK[port] |= mask;
+
+    platform_unlock(state);
+}
+
+/** \fn take_pinchange_edges
+ * This function returns edges seen on pin since last call, as
+ * PINCHANGE_RISING and PINCHANGE_FALLING flags, and clears them.
+ * @pin_number Number of pin
+ */
+uint8_t take_pinchange_edges(pin_t pin_number) {
+    uint8_t port = ((uint8_t) (pin_number)) / 8;
+    uint8_t mask = _BV (pin_number % 8);
+    uint8_t edges = 0x00;
+
+    uint8_t state = platform_lock();
+
+    if (pinchange_rising[port] & mask) edges |= PINCHANGE_RISING;
+    if (pinchange_falling[port] & mask) edges |= PINCHANGE_FALLING;
+
+    pinchange_rising[port] &= ~mask;
+    pinchange_falling[port] &= ~mask;
+
+    platform_unlock(state);
+
+    return edges;
+}
+
+/** \fn take_pinchange_port_edges
+ * This function returns masks of pins with rising and falling edges on port
+ * since last call, and clears them.
+ * @port Number of port, pin 0 is on port 0
+ * @*rising Memory for mask of pins with rising edge
+ * @*falling Memory for mask of pins with falling edge
+ */
+void take_pinchange_port_edges(
+    uint8_t port,
+    uint8_t *rising,
+    uint8_t *falling
+) {
+    uint8_t state = platform_lock();
+
+    *rising = pinchange_rising[port];
+    *falling = pinchange_falling[port];
+
+    pinchange_rising[port] = 0x00;
+    pinchange_falling[port] = 0x00;
+
+    platform_unlock(state);
 }
 
 /** \fn enable_pinchange_signal
@@ -75,33 +176,37 @@ void enable_pinchange_signal(void) {
     sei();
 }
 
-/* For all PCINT_vect make PINCHANGE_SIGNAL in system */
+/* All PCINT_vect find changed pins in the same way, so they share one ISR */
 #ifdef PCINT_vect
-ISR (PCINT_vect) { make_signal (PINCHANGE_SIGNAL); }
+#define PINCHANGE_vect PCINT_vect
+#else
+#define PINCHANGE_vect PCINT0_vect
 #endif
 
-#ifdef PCINT0_vect
-ISR (PCINT0_vect) { make_signal (PINCHANGE_SIGNAL); }
+ISR (PINCHANGE_vect) { handle_pinchange(); }
+
+#if defined(PCINT_vect) && defined(PCINT0_vect)
+ISR (PCINT0_vect, ISR_ALIASOF(PINCHANGE_vect));
 #endif
 
 #ifdef PCINT1_vect
-ISR (PCINT1_vect) { make_signal (PINCHANGE_SIGNAL); }
+ISR (PCINT1_vect, ISR_ALIASOF(PINCHANGE_vect));
 #endif
 
 #ifdef PCINT2_vect
-ISR (PCINT2_vect) { make_signal (PINCHANGE_SIGNAL); }
+ISR (PCINT2_vect, ISR_ALIASOF(PINCHANGE_vect));
 #endif
 
 #ifdef PCINT3_vect
-ISR (PCINT3_vect) { make_signal (PINCHANGE_SIGNAL); }
+ISR (PCINT3_vect, ISR_ALIASOF(PINCHANGE_vect));
 #endif
 
 #ifdef PCINT4_vect
-ISR (PCINT4_vect) { make_signal (PINCHANGE_SIGNAL); }
+ISR (PCINT4_vect, ISR_ALIASOF(PINCHANGE_vect));
 #endif
 
 #ifdef PCINT5_vect
-ISR (PCINT5_vect) { make_signal (PINCHANGE_SIGNAL); }
+ISR (PCINT5_vect, ISR_ALIASOF(PINCHANGE_vect));
 #endif
 
 #endif
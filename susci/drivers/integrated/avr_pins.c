@@ -64,6 +64,114 @@ void set_pin_state(pin_t pin_number, pin_state_t new_state) {
     SREG = sreg;
 }
 
+/** \fn set_pin_group_direction
+ * This set specified direction to all pins in group at once.
+ * @*group Group of pins
+ * @new_direction New direction of pins
+ */
+void set_pin_group_direction(
+    pin_group_t *group,
+    pin_direction_t new_direction
+) {
+    volatile uint8_t *direction = create_port_direction_pointer(group->port);
+
+    /* This is atomic operation */
+    uint8_t sreg = SREG;
+    cli();
+
+    if (new_direction == OUTPUT) *direction |= group->mask;
+    else *direction &= ~group->mask;
+
+    SREG = sreg;
+}
+
+/** \fn set_pin_group
+ * This set high state on all pins in group at once.
+ * @*group Group of pins
+ */
+void set_pin_group(pin_group_t *group) {
+    volatile uint8_t *output = create_port_output_pointer(group->port);
+
+    /* This is atomic operation */
+    uint8_t sreg = SREG;
+    cli();
+
+    *output |= group->mask;
+
+    SREG = sreg;
+}
+
+/** \fn clear_pin_group
+ * This set low state on all pins in group at once.
+ * @*group Group of pins
+ */
+void clear_pin_group(pin_group_t *group) {
+    volatile uint8_t *output = create_port_output_pointer(group->port);
+
+    /* This is atomic operation */
+    uint8_t sreg = SREG;
+    cli();
+
+    *output &= ~group->mask;
+
+    SREG = sreg;
+}
+
+/** \fn toggle_pin_group
+ * This toggles state of all pins in group at once.
+ * @*group Group of pins
+ */
+void toggle_pin_group(pin_group_t *group) {
+    /* Writing one to input register toggles output, it is atomic already */
+    *create_port_input_pointer(group->port) = group->mask;
+}
+
+/** \fn write_pin_group
+ * This writes value to pins in group at once, bit 0 of value goes to
+ * first pin of group. Other pins of port are not changed.
+ * @*group Group of pins
+ * @value New value of group
+ */
+void write_pin_group(pin_group_t *group, uint8_t value) {
+    volatile uint8_t *output = create_port_output_pointer(group->port);
+    uint8_t bits = (uint8_t) (value << group->shift) & group->mask;
+
+    /* This is atomic operation */
+    uint8_t sreg = SREG;
+    cli();
+
+    *output = (*output & ~group->mask) | bits;
+
+    SREG = sreg;
+}
+
+/** \fn read_pin_group
+ * This return current state of pins in group, first pin of group is bit 0.
+ * @*group Group of pins
+ */
+uint8_t read_pin_group(pin_group_t *group) {
+    return (uint8_t) (
+        (*create_port_input_pointer(group->port) & group->mask) >> group->shift
+    );
+}
+
+/** \fn snapshot_pins
+ * This reads inputs of all ports, one after another, without any change
+ * between them by processes or interrupts.
+ * @*snapshot Memory for PORTS_COUNT bytes, port of pin 0 is first
+ */
+void snapshot_pins(uint8_t *snapshot) {
+    /* This is atomic operation */
+    uint8_t sreg = SREG;
+    cli();
+
+    for (uint8_t port = 0; port < PORTS_COUNT; ++ port) {
+        snapshot[port] = *create_port_input_pointer(port);
+    }
+
+    SREG = sreg;
+}
+
 /** \fn get_pin_direction
  * This return current direction of pin specified in parameter.
  * @pin_number Number of pin
@@ -22,6 +22,35 @@
 #ifndef DRIVERS_INTEGRATED_AVRPINS_H_INCLUDED
 #define DRIVERS_INTEGRATED_AVRPINS_H_INCLUDED
 
+/* Port registers are also used by pinchange driver */
+#if defined(USE_AVR_PINS) || defined(USE_AVR_PINCHANGE)
+
+/** \fn create_port_direction_pointer
+ * This return pointer to direction register of port with given number.
+ * @port Number of port
+ */
+static inline volatile uint8_t *create_port_direction_pointer(uint8_t port) {
+    return (volatile uint8_t *) (LOW_DDR + port * 3);
+}
+
+/** \fn create_port_input_pointer
+ * This return pointer to input register of port with given number.
+ * @port Number of port
+ */
+static inline volatile uint8_t *create_port_input_pointer(uint8_t port) {
+    return (volatile uint8_t *) (LOW_PIN + port * 3);
+}
+
+/** \fn create_port_output_pointer
+ * This return pointer to output register of port with given number.
+ * @port Number of port
+ */
+static inline volatile uint8_t *create_port_output_pointer(uint8_t port) {
+    return (volatile uint8_t *) (LOW_PORT + port * 3);
+}
+
+#endif
+
 #ifdef USE_AVR_PINS
 
 /** \fn create_pin_direction_pointer
@@ -71,6 +100,104 @@ static inline uint8_t create_pin_mask(
     return _BV(pin_number % 8);
 }
 
+/** \def PIN_INLINE
+ * Pin access functions are always inlined, so with constant pin, pointer
+ * and mask are known at compile time, and access is one instruction.
+ */
+#define PIN_INLINE static inline __attribute__((always_inline))
+
+/** \fn pin_high
+ * This set high state on pin. With constant pin, for example PIN_n, it is
+ * one sbi instruction, that is atomic, else set_pin_state is called.
+ * @pin_number Number of pin
+ */
+PIN_INLINE void pin_high(pin_t pin_number) {
+    if (__builtin_constant_p(pin_number)) {
+        volatile uint8_t *output = create_pin_output_pointer(pin_number);
+
+        *output |= create_pin_mask(pin_number);
+    } else {
+        set_pin_state(pin_number, HIGH);
+    }
+}
+
+/** \fn pin_low
+ * This set low state on pin. With constant pin, for example PIN_n, it is
+ * one cbi instruction, that is atomic, else set_pin_state is called.
+ * @pin_number Number of pin
+ */
+PIN_INLINE void pin_low(pin_t pin_number) {
+    if (__builtin_constant_p(pin_number)) {
+        volatile uint8_t *output = create_pin_output_pointer(pin_number);
+
+        *output &= ~create_pin_mask(pin_number);
+    } else {
+        set_pin_state(pin_number, LOW);
+    }
+}
+
+/** \fn pin_write
+ * This set given state on pin, with constant pin and state it is one
+ * instruction.
+ * @pin_number Number of pin
+ * @new_state New pin state
+ */
+PIN_INLINE void pin_write(pin_t pin_number, pin_state_t new_state) {
+    if (new_state == HIGH) pin_high(pin_number);
+    else pin_low(pin_number);
+}
+
+/** \fn toggle_pin
+ * This toggles state of pin, by writing one to its input register. It is
+ * atomic, and with constant pin it is one sbi instruction.
+ * @pin_number Number of pin
+ */
+PIN_INLINE void toggle_pin(pin_t pin_number) {
+    *create_pin_input_pointer(pin_number) = create_pin_mask(pin_number);
+}
+
+/** \fn read_pin
+ * This return true when pin is in high state, with constant pin it is one
+ * sbis or sbic instruction.
+ * @pin_number Number of pin
+ */
+PIN_INLINE bool read_pin(pin_t pin_number) {
+    return (bool) (
+        (*create_pin_input_pointer(pin_number) & create_pin_mask(pin_number))
+        != 0
+    );
+}
+
+/** \fn pin_output
+ * This set pin as output. With constant pin it is one sbi instruction,
+ * else set_pin_direction is called.
+ * @pin_number Number of pin
+ */
+PIN_INLINE void pin_output(pin_t pin_number) {
+    if (__builtin_constant_p(pin_number)) {
+        volatile uint8_t *direction = create_pin_direction_pointer(pin_number);
+
+        *direction |= create_pin_mask(pin_number);
+    } else {
+        set_pin_direction(pin_number, OUTPUT);
+    }
+}
+
+/** \fn pin_input
+ * This set pin as input. With constant pin it is one cbi instruction, else
+ * set_pin_direction is called.
+ * @pin_number Number of pin
+ */
+PIN_INLINE void pin_input(pin_t pin_number) {
+    if (__builtin_constant_p(pin_number)) {
+        volatile uint8_t *direction = create_pin_direction_pointer(pin_number);
+
+        *direction &= ~create_pin_mask(pin_number);
+    } else {
+        set_pin_direction(pin_number, INPUT);
+    }
+}
+
 #endif
 
 
@@ -21,6 +21,8 @@
 
 #include "../../settings.h"
 #include "../../platforms/avr.h"
+#include "../../kernel/process.h"
+#include "../../kernel/scheduler.h"
 #include "../../kernel/interface.h"
 #include "avr_usi_twi_slave.h"
 
@@ -177,8 +179,53 @@ static inline void usi_twi_send_confirmation(void) {
     usi_twi_setup_counter_bit();
 }
 
+/** \var usi_twi_received
+ * True when master wrote any data to shared memory in current transaction.
+ */
+static volatile bool usi_twi_received = false;
+
+/** \fn usi_twi_end_write
+ * Ends write to shared memory, started when master polled device to write
+ * data. Readers of snapshot see all data written in transaction at once,
+ * and one TWI_SLAVE_RECEIVED_SIGNAL is made for whole transaction. Signal
+ * can be overwritten by other one, so receivers should look for changes in
+ * dirty regions of shared memory, not count signals.
+ * It must be called with interrupts disabled.
+ */
+static inline void usi_twi_end_write(void) {
+    if (is_shared_memory_writing(&twi_slave.shared)) {
+        end_shared_memory_write(&twi_slave.shared);
+    }
+
+    if (usi_twi_received) {
+        usi_twi_received = false;
+        make_signal(TWI_SLAVE_RECEIVED_SIGNAL);
+    }
+}
+
+/** \fn usi_twi_stop_service
+ * This is service for USI TWI slave. USI has no interrupt for stop
+ * condition, so this process looks for it while master is writing data,
+ * and then ends write to shared memory.
+ */
+exec_state_t usi_twi_stop_service(void *param) {
+    if (!is_shared_memory_writing(&twi_slave.shared)) return IDLE_STATE;
+    if (!(USI_STATUS & (1 << USIPF))) return IDLE_STATE;
+
+    /* Start interrupt can end write too, so this is atomic operation */
+    uint8_t sreg = SREG;
+    cli();
+
+    usi_twi_end_write();
+
+    SREG = sreg;
+
+    return GOOD_STATE;
+}
+
 /** \fn usi_twi_enable
- * Prepares the microcontroller and USI devices to work in the TWI bus.
+ * Prepares the microcontroller and USI devices to work in the TWI bus. This
+ * create new process in system for usi_twi_stop_service.
  */
 void usi_twi_enable(void) {
     usi_twi_set_port();
@@ -186,6 +233,8 @@ void usi_twi_enable(void) {
     usi_twi_setup_control_start();
     usi_twi_setup_counter_start();
 
+    create_process(get_first_empty(), usi_twi_stop_service, nullptr);
+
     sei();
 }
 
@@ -195,6 +244,7 @@ void usi_twi_enable(void) {
  */
 ISR (USI_START_INTERRUPT) {
     usi_twi_set_input();
+    usi_twi_end_write();
 
     while (usi_twi_wait_for_start_stop()) ;
 
@@ -239,6 +289,7 @@ ISR (USI_OVERFLOW_INTERRUPT) {
             if (get_twi_transmission_mode(buffer) == WRITE_MODE) {
                 twi_slave.state = RECEIVE_DATA_FROM_MASTER;
                 reset_shared_memory_pointer(&twi_slave.shared);
+                begin_shared_memory_write(&twi_slave.shared);
 		    } else {
                 twi_slave.state = SEND_DATA_TO_MASTER;
 			}
@@ -253,11 +304,12 @@ ISR (USI_OVERFLOW_INTERRUPT) {
 
             /*
              * If pointer in memory has been set, write received data to
-             *  memory and trigger signal, else received data is pointer.
+             * memory, signal is made when transaction ends, else received
+             * data is pointer.
              */
             if (is_set_shared_memory_pointer(&twi_slave.shared)){
                 write_shared_memory(&twi_slave.shared, buffer);
-                make_signal(TWI_SLAVE_RECEIVED_SIGNAL);
+                usi_twi_received = true;
 	        }else{
 	            set_shared_memory_pointer(&twi_slave.shared, buffer);
             }
@@ -19,6 +19,7 @@
  * redesign it a bit to better fit Susci.
  */
 
+#include "../../kernel/process.h"
 #include "../../communication/twi_slave.h"
 
 #ifndef DRIVERS_INTEGRATED_TINY_TWI_SLAVE_H_INCLUDED
@@ -28,8 +29,16 @@
 
 extern twi_interface_t twi_slave;
 
+/** \fn usi_twi_stop_service
+ * This is service for USI TWI slave. USI has no interrupt for stop
+ * condition, so this process looks for it while master is writing data,
+ * and then ends write to shared memory.
+ */
+exec_state_t usi_twi_stop_service(void *param);
+
 /** \fn usi_twi_enable
- * Prepares the microcontroller and USI devices to work in the TWI bus.
+ * Prepares the microcontroller and USI devices to work in the TWI bus. This
+ * create new process in system for usi_twi_stop_service.
  */
 void usi_twi_enable(void);
 
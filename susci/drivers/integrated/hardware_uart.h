@@ -16,7 +16,8 @@
 #include "../../settings.h"
 #include "../../kernel/types.h"
 #include "../../kernel/process.h"
-#include "../../synchronization/buffer.h"
+#include "../../synchronization/ring_buffer.h"
+#include "../../synchronization/shared_memory.h"
 #include "../../platforms/avr.h"
 
 #ifndef DRIVERS_INTEGRATED_HARDWARE_UART_H_INCLUDED
@@ -24,22 +25,262 @@
 
 #ifdef USE_AVR_HARDWARE_UART
 
-extern buffer_t hardware_uart_sender;
-extern buffer_t hardware_uart_receiver;
+/** \def UART_TX_SIZE
+ * Size of uart transmit buffer, it must be power of two, up to 128.
+ */
+#ifndef UART_TX_SIZE
+#define UART_TX_SIZE 16
+#endif
+
+/** \def UART_TX_LOW_WATERMARK
+ * When count of data in transmit buffer drops to it, HARDWARE_UART_LOW_SIGNAL
+ * is made, so producer can fill buffer before it drains.
+ */
+#ifndef UART_TX_LOW_WATERMARK
+#define UART_TX_LOW_WATERMARK (UART_TX_SIZE / 4)
+#endif
+
+/** \def HARDWARE_UART_SENT_SIGNAL
+ * Signal made when all data from transmit buffer has been sent.
+ */
+#define HARDWARE_UART_SENT_SIGNAL 0x30
+
+/** \def HARDWARE_UART_LOW_SIGNAL
+ * Signal made when count of data in transmit buffer drops to
+ * UART_TX_LOW_WATERMARK.
+ */
+#define HARDWARE_UART_LOW_SIGNAL 0x31
+
+/** \def UART_RX_SIZE
+ * Size of uart receive buffer, it must be power of two, up to 128.
+ */
+#ifndef UART_RX_SIZE
+#define UART_RX_SIZE 16
+#endif
+
+/** \def UART_RX_DELIMITER
+ * Frames end with FRAME_END, so receiver is woken up for every frame.
+ */
+#if defined(USE_FRAME) && !defined(UART_RX_DELIMITER)
+#define UART_RX_DELIMITER 0xC0
+#endif
+
+/** \def UART_RX_THRESHOLD
+ * When count of data in receive buffer grows to it, receiver is woken up.
+ */
+#ifndef UART_RX_THRESHOLD
+#define UART_RX_THRESHOLD (UART_RX_SIZE / 2)
+#endif
+
+/** \def UART_RX_IDLE_CHARS
+ * When no char comes for time of this count of chars, and receive buffer
+ * is not empty, receiver is woken up. Time is computed from speed given to
+ * enable_hardware_uart. Set it to 0 to not use timer for it.
+ */
+#ifndef UART_RX_IDLE_CHARS
+#define UART_RX_IDLE_CHARS 3
+#endif
+
+/** \def HARDWARE_UART_RECEIVED_SIGNAL
+ * Signal made when UART_RX_THRESHOLD chars are in receive buffer, when
+ * UART_RX_DELIMITER comes, if it is defined, or when line is idle for
+ * UART_RX_IDLE_CHARS.
+ */
+#define HARDWARE_UART_RECEIVED_SIGNAL 0x32
+
+/** \def UART_QUEUE_SIZE
+ * Count of transfers that can wait for sending, it must be power of two.
+ */
+#ifndef UART_QUEUE_SIZE
+#define UART_QUEUE_SIZE 4
+#endif
+
+/** \enum uart_source_t
+ * Memory that transfer sends data from.
+ */
+typedef enum {
+
+    /* Data is in RAM */
+    UART_SOURCE_RAM = 0,
+
+    /* Data is in flash, declared with PROGMEM */
+    UART_SOURCE_FLASH = 1,
+
+    /* Data is in shared memory */
+    UART_SOURCE_SHARED = 2
+
+} uart_source_t;
+
+/** \struct uart_transfer_t
+ * This struct describes data that interrupt sends directly from its memory,
+ * without copy to transmit buffer. It is owned by sender, and must not
+ * change until transfer is done.
+ */
+typedef struct {
 
-#define print_buffer (&hardware_uart_sender)
-#define input_buffer (&hardware_uart_receiver)
+    /* Data in RAM or flash, not used for shared memory */
+    const char *data;
+
+    /* Shared memory, used only for shared memory */
+    shared_memory_t *shared;
+
+    /* Next address in shared memory */
+    volatile uint8_t address;
+
+    /* Count of data that is not sent yet */
+    volatile uint8_t length;
+
+    /* Memory of data */
+    uart_source_t source;
+
+    /* Signal made when transfer is done, or 0x00 */
+    signal_t signal;
+
+    /* Transmit buffer position of first char written after transfer */
+    uint8_t mark;
+
+} uart_transfer_t;
+
+/** \fn create_uart_ram_transfer
+ * This function creates transfer of data from RAM.
+ * @*data Data to send
+ * @length Count of data
+ * @signal Signal made when transfer is done, or 0x00
+ */
+static inline uart_transfer_t create_uart_ram_transfer(
+    const char *data,
+    uint8_t length,
+    signal_t signal
+) {
+    return (uart_transfer_t) {
+        data, nullptr, 0x00, length, UART_SOURCE_RAM, signal, 0x00
+    };
+}
+
+/** \fn create_uart_flash_transfer
+ * This function creates transfer of data from flash, declared with PROGMEM.
+ * @*data Data to send
+ * @length Count of data
+ * @signal Signal made when transfer is done, or 0x00
+ */
+static inline uart_transfer_t create_uart_flash_transfer(
+    const char *data,
+    uint8_t length,
+    signal_t signal
+) {
+    return (uart_transfer_t) {
+        data, nullptr, 0x00, length, UART_SOURCE_FLASH, signal, 0x00
+    };
+}
+
+/** \fn create_uart_shared_transfer
+ * This function creates transfer of data from shared memory, for example
+ * registers of TWI slave. Data is read when it is sent.
+ * @*shared Shared memory
+ * @address First address to send
+ * @length Count of data
+ * @signal Signal made when transfer is done, or 0x00
+ */
+static inline uart_transfer_t create_uart_shared_transfer(
+    shared_memory_t *shared,
+    uint8_t address,
+    uint8_t length,
+    signal_t signal
+) {
+    return (uart_transfer_t) {
+        nullptr, shared, address, length, UART_SOURCE_SHARED, signal, 0x00
+    };
+}
+
+/** \fn is_uart_transfer_done
+ * This function returns true when all data of transfer has been sent, and
+ * sender can change it.
+ * @*transfer Transfer to check
+ */
+static inline bool is_uart_transfer_done(uart_transfer_t *transfer) {
+    return (bool) (transfer->length == 0x00);
+}
+
+extern ring_buffer_t hardware_uart_sender;
+extern ring_buffer_t hardware_uart_receiver;
+
+/** \var hardware_uart_dropped
+ * Count of received chars, that was lost because receive buffer was full.
+ */
+extern volatile uint8_t hardware_uart_dropped;
+
+/** \fn start_hardware_uart
+ * This function starts sending data from transmit buffer by interrupt. Call
+ * it after writing directly to hardware_uart_sender.
+ */
+void start_hardware_uart(void);
+
+/** \fn write_hardware_uart
+ * This function puts char into transmit buffer, and starts sending it by
+ * interrupt. Return false when buffer is full, and char is not sent.
+ * @data Char to send
+ */
+bool write_hardware_uart(char data);
+
+/** \fn write_hardware_uart_span
+ * This function puts as many of given chars as fit into transmit buffer,
+ * and starts sending them by interrupt. Return count of chars put.
+ * @*data Chars to send
+ * @length Count of chars
+ */
+uint8_t write_hardware_uart_span(const char *data, uint8_t length);
+
+/** \fn send_hardware_uart_transfer
+ * This function puts transfer into queue, and starts sending it by
+ * interrupt. Return false when queue is full. Data is sent in order it was
+ * given, chars written to transmit buffer before transfer are sent before
+ * it, and chars written after it are sent after its end.
+ * @*transfer Transfer to send
+ */
+bool send_hardware_uart_transfer(uart_transfer_t *transfer);
+
+/** \fn get_hardware_uart_free
+ * This function returns count of chars that fit into transmit buffer now.
+ */
+static inline uint8_t get_hardware_uart_free(void) {
+    return get_ring_buffer_free(&hardware_uart_sender);
+}
+
+/** \fn read_hardware_uart_span
+ * This function reads as many received chars as there are, up to given
+ * length, into given memory. Return count of read chars.
+ * @*data Memory to read to
+ * @length Max count of chars to read
+ */
+static inline uint8_t read_hardware_uart_span(char *data, uint8_t length) {
+    return read_ring_buffer_span(&hardware_uart_receiver, data, length);
+}
+
+/** \fn get_hardware_uart_available
+ * This function returns count of received chars waiting in buffer.
+ */
+static inline uint8_t get_hardware_uart_available(void) {
+    return get_ring_buffer_count(&hardware_uart_receiver);
+}
+
+/** \fn get_hardware_uart_dropped
+ * This function returns count of received chars, that was lost because
+ * receive buffer was full.
+ */
+static inline uint8_t get_hardware_uart_dropped(void) {
+    return hardware_uart_dropped;
+}
 
-/** \fn hardware_uart_sender_service
- * This is service for hardware uart. If any data is in buffer, it send one
- * char from it to uart device. It use hardware_uart_sender aka print_buffer
- * that is global var, you must set nullptr as param for this process.
+/** \fn is_hardware_uart_idle
+ * This function returns true when every char has been shifted out, no
+ * received char waits in data register, and no message is being received,
+ * so line is idle for UART_RX_IDLE_CHARS. Char that starts while clock of
+ * uart is stopped is still lost.
  */
-exec_state_t hardware_uart_sender_service(void *param);
+bool is_hardware_uart_idle(void);
 
 /** \fn enable_hardware_uart
- * This function setup uart device to work in system. This create new process
- * in system for uart_sender and turn on interrupts.
+ * This function setup uart device to work in system, and turn on interrupts.
  * @speed uart buadrate
  */
 void enable_hardware_uart(long speed);
@@ -14,6 +14,8 @@
  */
 
 #include "../../settings.h"
+#include "../../kernel/types.h"
+#include "../../platforms/avr.h"
 #include "pins.h"
 
 #ifndef DRIVERS_INTEGRATED_PINCHANGE_H_INCLUDED
@@ -26,12 +28,54 @@
  */
 #define PINCHANGE_SIGNAL 0x20
 
+/** \def PINCHANGE_RISING
+ * Flag of pin edge from low to high state.
+ */
+#define PINCHANGE_RISING 0x01
+
+/** \def PINCHANGE_FALLING
+ * Flag of pin edge from high to low state.
+ */
+#define PINCHANGE_FALLING 0x02
+
+/*
+ * Define PINCHANGE_ROUTES in settings.h to make own signal for change of
+ * given pins, PINCHANGE_SIGNAL is made only when none of them changed:
+ *
+ * #define PINCHANGE_ROUTES \
+ *     PINCHANGE_ROUTE(PIN_14, 0x21) \
+ *     PINCHANGE_ROUTE(PIN_15, 0x22)
+ *
+ * When many pins change at once, only one signal is kept by the system, so
+ * receivers should take edges of all their pins.
+ */
+
 /** \fn setup_pinchange_on_pin
  * This function enable pinchange on specified pin.
  * @pin_number Number of pin
  */
 void setup_pinchange_on_pin(pin_t pin_number);
 
+/** \fn take_pinchange_edges
+ * This function returns edges seen on pin since last call, as
+ * PINCHANGE_RISING and PINCHANGE_FALLING flags, and clears them.
+ * @pin_number Number of pin
+ */
+uint8_t take_pinchange_edges(pin_t pin_number);
+
+/** \fn take_pinchange_port_edges
+ * This function returns masks of pins with rising and falling edges on port
+ * since last call, and clears them.
+ * @port Number of port, pin 0 is on port 0
+ * @*rising Memory for mask of pins with rising edge
+ * @*falling Memory for mask of pins with falling edge
+ */
+void take_pinchange_port_edges(
+    uint8_t port,
+    uint8_t *rising,
+    uint8_t *falling
+);
+
 /** \fn enable_pinchange_signal
  * This enable Pinchange interrupt in system. You must call them BEFORE 
  * setup pinchange on pins.
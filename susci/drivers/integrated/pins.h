@@ -48,6 +48,68 @@ typedef enum {
 
 } pin_state_t;
 
+/** \struct pin_group_t
+ * This is type for group of pins on the same port, that are changed at
+ * once.
+ */
+typedef struct {
+
+    /* Number of port */
+    uint8_t port;
+
+    /* Mask of pins in port */
+    uint8_t mask;
+
+    /* Bit of first pin, value of group is shifted by it */
+    uint8_t shift;
+
+} pin_group_t;
+
+/** \fn pin_group_crosses_port
+ * This is never defined, call to it that is not optimized out stops
+ * compilation, when constant pin group does not fit in one port.
+ */
+extern void pin_group_crosses_port(void)
+    __attribute__((error("pin group must be on one port")));
+
+/** \fn create_pin_group
+ * This return group of given count of pins, starting from given pin. All
+ * of them must be on the same port, else group is empty, with mask 0x00,
+ * and compilation fails when pin and count are constant.
+ * @first_pin Number of first pin
+ * @count Count of pins
+ */
+static inline pin_group_t create_pin_group(pin_t first_pin, uint8_t count) {
+    uint8_t shift = first_pin % 8;
+
+    if (shift + count > 8) {
+        if (__builtin_constant_p(first_pin) && __builtin_constant_p(count)) {
+            pin_group_crosses_port();
+        }
+
+        return (pin_group_t) {(uint8_t) (first_pin / 8), 0x00, shift};
+    }
+
+    return (pin_group_t) {
+        (uint8_t) (first_pin / 8),
+        (uint8_t) (((1 << count) - 1) << shift),
+        shift
+    };
+}
+
+/** \fn add_pin_to_group
+ * This adds pin to group, return false when pin is on other port.
+ * @*group Group of pins
+ * @pin_number Number of pin
+ */
+static inline bool add_pin_to_group(pin_group_t *group, pin_t pin_number) {
+    if (pin_number / 8 != group->port) return false;
+
+    group->mask |= (uint8_t) (1 << (pin_number % 8));
+
+    return true;
+}
+
 /** \fn set_pin_direction
  * This set specified direction to specified pin. 
  * @pin_number Number of pin
@@ -75,4 +137,53 @@ pin_direction_t get_pin_direction(pin_t pin_number);
  */
 pin_state_t get_pin_state(pin_t pin_number);
 
+/** \fn set_pin_group_direction
+ * This set specified direction to all pins in group at once.
+ * @*group Group of pins
+ * @new_direction New direction of pins
+ */
+void set_pin_group_direction(
+    pin_group_t *group,
+    pin_direction_t new_direction
+);
+
+/** \fn set_pin_group
+ * This set high state on all pins in group at once.
+ * @*group Group of pins
+ */
+void set_pin_group(pin_group_t *group);
+
+/** \fn clear_pin_group
+ * This set low state on all pins in group at once.
+ * @*group Group of pins
+ */
+void clear_pin_group(pin_group_t *group);
+
+/** \fn toggle_pin_group
+ * This toggles state of all pins in group at once.
+ * @*group Group of pins
+ */
+void toggle_pin_group(pin_group_t *group);
+
+/** \fn write_pin_group
+ * This writes value to pins in group at once, bit 0 of value goes to
+ * first pin of group. Other pins of port are not changed.
+ * @*group Group of pins
+ * @value New value of group
+ */
+void write_pin_group(pin_group_t *group, uint8_t value);
+
+/** \fn read_pin_group
+ * This return current state of pins in group, first pin of group is bit 0.
+ * @*group Group of pins
+ */
+uint8_t read_pin_group(pin_group_t *group);
+
+/** \fn snapshot_pins
+ * This reads inputs of all ports, one after another, without any change
+ * between them by processes or interrupts.
+ * @*snapshot Memory for PORTS_COUNT bytes, port of pin 0 is first
+ */
+void snapshot_pins(uint8_t *snapshot);
+
 #endif
@@ -31,11 +31,18 @@
 #include "kernel/interface.h"
 #include "kernel/time.h"
 #include "kernel/loader.h"
+#include "kernel/load.h"
+#include "kernel/stack.h"
+#include "kernel/scratch.h"
 
 /* Include synchronization files */
 #include "synchronization/buffer.h"
 #include "synchronization/semaphore.h"
 #include "synchronization/circular_buffer.h"
+#include "synchronization/ring_buffer.h"
+#include "synchronization/double_buffer.h"
+#include "synchronization/pool.h"
+#include "synchronization/topic.h"
 #include "synchronization/shared_memory.h"
 #include "synchronization/latch.h"
 
@@ -44,6 +51,8 @@
 
 /* Include drivers */
 #include "communication/twi_slave.h"
+#include "communication/frame.h"
+#include "communication/log.h"
 #include "drivers/register/shift_register.h"
 #include "drivers/integrated/pinchange.h"
 #include "drivers/integrated/pins.h"
@@ -0,0 +1,70 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores the CPU load monitor. It measures how much of every window
+ * is spent in workers, and how much in idle scanning of the process heap or
+ * in workers that returned IDLE_STATE.
+ */
+
+#include "../settings.h"
+#include "types.h"
+#include "process.h"
+#include "time.h"
+#include "platform.h"
+#include "load.h"
+
+#ifdef USE_LOAD_MONITOR
+
+/** \var load_monitor
+ * CPU load monitor of the system.
+ */
+load_monitor_t load_monitor;
+
+/** \fn account_worker_time
+ * This function is called by scheduler after every worker call, it adds time
+ * spent in worker to the busy time when worker did any work.
+ * @start System time when worker was called
+ * @state State returned by worker
+ */
+void account_worker_time(system_tick_t start, exec_state_t state) {
+    if (state == IDLE_STATE) return;
+
+    /* Unsigned subtraction handles timer overflow */
+    load_monitor.busy_ticks += (system_tick_t) (get_time() - start);
+}
+
+/** \fn check_load_window
+ * A function that should only be called by the system loader, it closes
+ * measurement window when it expired and calculates load in it.
+ */
+void check_load_window(void) {
+    system_tick_t now = get_time();
+    system_tick_t elapsed = (system_tick_t) (now - load_monitor.window_start);
+
+    if (elapsed < LOAD_WINDOW) return;
+
+    /* Worker started in previous window can be longer than this window */
+    if (load_monitor.busy_ticks > elapsed) load_monitor.busy_ticks = elapsed;
+
+    load_monitor.load = (uint8_t) (
+        ((unsigned long) load_monitor.busy_ticks * 100) / elapsed
+    );
+
+    if (load_monitor.load > load_monitor.peak_load) {
+        load_monitor.peak_load = load_monitor.load;
+    }
+
+    load_monitor.busy_ticks = 0x00;
+    load_monitor.window_start = now;
+}
+
+#endif
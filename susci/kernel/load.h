@@ -0,0 +1,98 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores the CPU load monitor. It measures how much of every window
+ * is spent in workers, and how much in idle scanning of the process heap or
+ * in workers that returned IDLE_STATE.
+ */
+
+#include "../settings.h"
+#include "types.h"
+#include "process.h"
+#include "time.h"
+
+#ifndef KERNEL_LOAD_H_INCLUDED
+#define KERNEL_LOAD_H_INCLUDED
+
+#ifdef USE_LOAD_MONITOR
+
+/** \def LOAD_WINDOW
+ * Length of measurement window in system ticks. Default is one second for
+ * system timer running with F_CPU / 1024 Hz frequency.
+ */
+#ifndef LOAD_WINDOW
+#define LOAD_WINDOW ((system_tick_t) ((F_CPU) / 1024))
+#endif
+
+/** \struct load_monitor_t
+ * This struct stores state of the CPU load monitor.
+ */
+typedef struct {
+
+    /* Time when current window started */
+    system_tick_t window_start;
+
+    /* Ticks spent in workers in current window */
+    system_tick_t busy_ticks;
+
+    /* Load in last finished window, in percents */
+    uint8_t load;
+
+    /* Highest load seen in any window, in percents */
+    uint8_t peak_load;
+
+} load_monitor_t;
+
+/** \var load_monitor
+ * CPU load monitor of the system.
+ */
+extern load_monitor_t load_monitor;
+
+/** \fn account_worker_time
+ * This function is called by scheduler after every worker call, it adds time
+ * spent in worker to the busy time when worker did any work.
+ * @start System time when worker was called
+ * @state State returned by worker
+ */
+void account_worker_time(system_tick_t start, exec_state_t state);
+
+/** \fn check_load_window
+ * A function that should only be called by the system loader, it closes
+ * measurement window when it expired and calculates load in it.
+ */
+void check_load_window(void);
+
+/** \fn get_cpu_load
+ * This function returns CPU load in last finished window, in percents.
+ */
+static inline uint8_t get_cpu_load(void) {
+    return load_monitor.load;
+}
+
+/** \fn get_peak_cpu_load
+ * This function returns highest CPU load seen since boot or since last
+ * reset of peak, in percents.
+ */
+static inline uint8_t get_peak_cpu_load(void) {
+    return load_monitor.peak_load;
+}
+
+/** \fn reset_peak_cpu_load
+ * This function resets highest seen CPU load.
+ */
+static inline void reset_peak_cpu_load(void) {
+    load_monitor.peak_load = 0x00;
+}
+
+#endif
+
+#endif
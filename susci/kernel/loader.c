@@ -21,6 +21,8 @@
 #include "time.h"
 #include "loader.h"
 #include "platform.h"
+#include "load.h"
+#include "stack.h"
 
 /** \fn main 
  * Overwriting the function with the main system bootloader.
@@ -29,10 +31,26 @@ int main(void) {
     /* Init all modules */
     platform_init();
     scheduler_init();
+
+#ifdef USE_STACK_MONITOR
+    stack_monitor_init();
+#endif
+
     susci_boot();
 
+    exec_state_t state;
+
     /* Run scheduler and timer */
-    while (scheduler_loop() == GOOD_STATE) check_timer_processes();
+    while ((state = scheduler_loop()) != PANIC_STATE) {
+        check_timer_processes();
+
+#ifdef USE_LOAD_MONITOR
+        check_load_window();
+#endif
+
+        /* No process could do any work, platform can sleep */
+        if (state == IDLE_STATE) platform_idle();
+    }
 
     /* Any process return PANIC_STATE, handle error */
     susci_panic();
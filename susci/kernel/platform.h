@@ -16,6 +16,8 @@
  * platform dependent types.
  */
 
+#include "../settings.h"
+#include "types.h"
 #include "time.h"
 
 #ifndef KERNEL_PLATFORM_H_INCLUDED
@@ -34,6 +36,41 @@ void platform_init(void);
  */
 system_tick_t get_time(void);
 
+/** \fn platform_idle
+ * This function is called by loader when no process did any work. Platform
+ * can sleep here, but only when interrupt that wakes it up is sure to come,
+ * because system timer has no interrupt.
+ */
+void platform_idle(void);
+
+/** \fn platform_lock
+ * This function pauses interrupts and returns previous interrupt state, that
+ * must be given to platform_unlock. Code between them is atomic, also when
+ * it is called from interrupt.
+ */
+uint8_t platform_lock(void);
+
+/** \fn platform_unlock
+ * This function restores interrupt state returned by platform_lock.
+ * @state Interrupt state from platform_lock
+ */
+void platform_unlock(uint8_t state);
+
+#ifdef USE_STACK_MONITOR
+
+/** \fn get_stack_bottom
+ * This function returns lowest address that stack can grow to. Memory from
+ * it to the top of stack must be painted with STACK_PAINT at boot.
+ */
+uint8_t *get_stack_bottom(void);
+
+/** \fn get_stack_top
+ * This function returns highest address of stack.
+ */
+uint8_t *get_stack_top(void);
+
+#endif
+
 /** \def PLATFORM_INCLUDE_FLAG
  * Sets a flag indicating that the platform file has been included.
  */
@@ -18,6 +18,10 @@
 #include "types.h"
 #include "process.h"
 #include "scheduler.h"
+#include "platform.h"
+#include "load.h"
+#include "stack.h"
+#include "scratch.h"
 
 /** \def MAX_PRIORITY_pid_t
  * Define process who have highest priority
@@ -103,6 +107,33 @@ exec_state_t kill_process(pid_t to_kill) {
     return GOOD_STATE;
 }
 
+/** \fn run_current_process
+ * This function runs worker of the current process. Everything what kernel
+ * must do around every worker call is placed here, so both schedulers share
+ * it.
+ */
+static inline exec_state_t run_current_process(void) {
+#ifdef USE_LOAD_MONITOR
+    system_tick_t start = get_time();
+#endif
+
+    exec_state_t state = current_process->worker(current_process->parameter);
+
+#ifdef USE_LOAD_MONITOR
+    account_worker_time(start, state);
+#endif
+
+#ifdef USE_SCRATCH
+    reset_scratch();
+#endif
+
+#ifdef USE_STACK_MONITOR
+    if (check_stack() == PANIC_STATE) return PANIC_STATE;
+#endif
+
+    return state;
+}
+
 /** \fn signal_scheduler
  * This function is the signal system scheduler, if system signal flag is 
  * set, then searching processes with SIGNAL_STATE with same signal, then 
@@ -129,8 +160,7 @@ static inline exec_state_t signal_scheduler(void) {
 
 		if (current_process->scheduler_context != signal) continue;
 		
-		exec_state_t return_state 
-		= current_process->worker(current_process->parameter);
+		exec_state_t return_state = run_current_process();
 
 		if (return_state == PANIC_STATE) return PANIC_STATE;
 	}
@@ -141,7 +171,8 @@ static inline exec_state_t signal_scheduler(void) {
 /** \fn standard_scheduler
  * This function is the system standard scheduler, searching any process in 
  * READY_STATE_STATE, if exist, run it and return result, if any process does 
- * not have READY_STATE_STATE, return GOOD_STATE_STATE.
+ * not have READY_STATE_STATE, or all of them returned IDLE_STATE, return
+ * IDLE_STATE, so loader knows that system can sleep.
  */
 static inline exec_state_t standard_scheduler(void) {
     current_process = MAX_PRIORITY_PROCESS + 1;
@@ -149,22 +180,22 @@ static inline exec_state_t standard_scheduler(void) {
 	while (current_process-- > MIN_PRIORITY_PROCESS) {
 		if (current_process->state != READY_STATE) continue;
 
-		exec_state_t process_state  
-		= current_process->worker(current_process->parameter);
+		exec_state_t process_state = run_current_process();
 
 		if (process_state == IDLE_STATE) continue;
 
 		return process_state;
 	}
 
-	return GOOD_STATE;
+	return IDLE_STATE;
 }
 
 /** \fn scheduler_loop 
  * This function is the system scheduler, responsible for calling the
  * appropriate process. If everything went well, it will return GOOD_STATE_STATE, 
- * but if it was not successful, it will return PANIC_STATE. The loader will
- * then call the susci_panic(void) function.
+ * or IDLE_STATE when no process did any work, but if it was not successful,
+ * it will return PANIC_STATE. The loader will then call the
+ * susci_panic(void) function.
  */
 exec_state_t scheduler_loop(void) {   
     exec_state_t signal = signal_scheduler();
@@ -101,8 +101,9 @@ static inline void scheduler_init(void) {
 /** \fn scheduler_loop 
  * This function is the system scheduler, responsible for calling the
  * appropriate process. If everything went well, it will return GOOD_STATE_STATE, 
- * but if it was not successful, it will return PANIC_STATE. The loader will
- * then call the susci_panic(void) function.
+ * or IDLE_STATE when no process did any work, but if it was not successful,
+ * it will return PANIC_STATE. The loader will then call the
+ * susci_panic(void) function.
  */
 exec_state_t scheduler_loop(void);
 
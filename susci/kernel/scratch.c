@@ -0,0 +1,52 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores the scratch arena. Workers run to completion and never
+ * run at once, so memory that worker needs only during one call can be
+ * shared by all workers. Scheduler frees whole arena after every worker.
+ */
+
+#include "../settings.h"
+#include "types.h"
+#include "scratch.h"
+
+#ifdef USE_SCRATCH
+
+/** \var scratch_arena
+ * Scratch arena of the system.
+ */
+scratch_arena_t scratch_arena;
+
+/** \fn scratch_alloc
+ * This function gives memory for current worker call, or returns nullptr
+ * when arena is too small. Memory is valid until worker returns, so it can
+ * not be used in interrupts, or kept for next call.
+ * @size Count of bytes to give
+ */
+void *scratch_alloc(uint16_t size) {
+    if (size > SCRATCH_SIZE - scratch_arena.used) {
+        if (scratch_arena.failures != 0xFF) ++ scratch_arena.failures;
+
+        return nullptr;
+    }
+
+    void *memory = scratch_arena.area + scratch_arena.used;
+    scratch_arena.used += size;
+
+    if (scratch_arena.used > scratch_arena.peak) {
+        scratch_arena.peak = scratch_arena.used;
+    }
+
+    return memory;
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores the scratch arena. Workers run to completion and never
+ * run at once, so memory that worker needs only during one call can be
+ * shared by all workers. Scheduler frees whole arena after every worker.
+ */
+
+#include "../settings.h"
+#include "types.h"
+
+#ifndef KERNEL_SCRATCH_H_INCLUDED
+#define KERNEL_SCRATCH_H_INCLUDED
+
+#ifdef USE_SCRATCH
+
+/** \def SCRATCH_SIZE
+ * Size of scratch arena in bytes.
+ */
+#ifndef SCRATCH_SIZE
+#define SCRATCH_SIZE 64
+#endif
+
+/** \struct scratch_arena_t
+ * This struct stores state of the scratch arena.
+ */
+typedef struct {
+
+    /* Count of bytes given to current worker */
+    uint16_t used;
+
+    /* Most bytes given to one worker */
+    uint16_t peak;
+
+    /* Count of allocations that failed because arena was too small */
+    uint8_t failures;
+
+    /* Memory of arena */
+    char area[SCRATCH_SIZE];
+
+} scratch_arena_t;
+
+/** \var scratch_arena
+ * Scratch arena of the system.
+ */
+extern scratch_arena_t scratch_arena;
+
+/** \fn scratch_alloc
+ * This function gives memory for current worker call, or returns nullptr
+ * when arena is too small. Memory is valid until worker returns, so it can
+ * not be used in interrupts, or kept for next call.
+ * @size Count of bytes to give
+ */
+void *scratch_alloc(uint16_t size);
+
+/** \fn reset_scratch
+ * This function is called by scheduler after every worker, it frees all
+ * memory given from the arena.
+ */
+static inline void reset_scratch(void) {
+    scratch_arena.used = 0x00;
+}
+
+/** \fn get_scratch_peak
+ * This function returns most bytes given to one worker call.
+ */
+static inline uint16_t get_scratch_peak(void) {
+    return scratch_arena.peak;
+}
+
+/** \fn get_scratch_failures
+ * This function returns count of allocations that failed, because arena
+ * was too small.
+ */
+static inline uint8_t get_scratch_failures(void) {
+    return scratch_arena.failures;
+}
+
+#endif
+
+#endif
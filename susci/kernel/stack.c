@@ -0,0 +1,112 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores the stack monitor. All workers and interrupts share one
+ * stack, the platform paints free memory below it at boot, and the monitor
+ * looks for the deepest painted byte that has been overwritten.
+ */
+
+#include "../settings.h"
+#include "types.h"
+#include "process.h"
+#include "scheduler.h"
+#include "platform.h"
+#include "stack.h"
+
+#ifdef USE_STACK_MONITOR
+
+/** \var stack_monitor
+ * Stack monitor of the system.
+ */
+stack_monitor_t stack_monitor;
+
+/** \fn update_low_water
+ * This function stores new deepest stack use and checks guard zone.
+ * @*low_water New deepest overwritten byte
+ * @process Process that was running
+ */
+static inline void update_low_water(uint8_t *low_water, pid_t process) {
+    stack_monitor.low_water = low_water;
+    stack_monitor.max_usage = (uint16_t) (get_stack_top() - low_water + 1);
+    stack_monitor.deepest_process = process;
+
+    if (low_water < get_stack_bottom() + STACK_GUARD_SIZE) {
+        stack_monitor.guard_touched = true;
+    }
+}
+
+/** \fn stack_monitor_init
+ * This function prepares stack monitor, it must be called after platform
+ * initialization, when stack is already painted.
+ */
+void stack_monitor_init(void) {
+    stack_monitor.low_water = get_stack_top() + 1;
+    stack_monitor.max_usage = 0x00;
+    stack_monitor.deepest_process = STACK_UNKNOWN_PROCESS;
+    stack_monitor.guard_touched = false;
+
+    scan_stack_usage();
+}
+
+/** \fn check_stack
+ * This function is called by scheduler after every worker. It looks for new
+ * deepest stack use and checks guard zone. Return PANIC_STATE when guard
+ * was touched and STACK_GUARD_PANIC is set, or GOOD_STATE.
+ */
+exec_state_t check_stack(void) {
+    uint8_t *bottom = get_stack_bottom();
+    uint8_t *position = stack_monitor.low_water;
+    uint8_t *low_water = position;
+    uint8_t window = STACK_SCAN_WINDOW;
+
+    /*
+     * Walk down from deepest known use, every overwritten byte found opens
+     * new window, so scan stops after STACK_SCAN_WINDOW painted bytes.
+     */
+    while (window-- && position > bottom) {
+        if (*--position == STACK_PAINT) continue;
+
+        low_water = position;
+        window = STACK_SCAN_WINDOW;
+    }
+
+    if (low_water != stack_monitor.low_water) {
+        update_low_water(low_water, (pid_t) (current_process - process_heap));
+    }
+
+#ifdef STACK_GUARD_PANIC
+    if (stack_monitor.guard_touched) return PANIC_STATE;
+#endif
+
+    return GOOD_STATE;
+}
+
+/** \fn scan_stack_usage
+ * This function scans whole painted memory from bottom, it is slow, but it
+ * finds deepest use even behind holes bigger than STACK_SCAN_WINDOW. Return
+ * most bytes of stack used at once.
+ */
+uint16_t scan_stack_usage(void) {
+    uint8_t *position = get_stack_bottom();
+
+    while (position < stack_monitor.low_water && *position == STACK_PAINT) {
+        ++ position;
+    }
+
+    if (position < stack_monitor.low_water) {
+        update_low_water(position, STACK_UNKNOWN_PROCESS);
+    }
+
+    return stack_monitor.max_usage;
+}
+
+#endif
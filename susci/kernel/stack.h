@@ -0,0 +1,124 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores the stack monitor. All workers and interrupts share one
+ * stack, the platform paints free memory below it at boot, and the monitor
+ * looks for the deepest painted byte that has been overwritten.
+ */
+
+#include "../settings.h"
+#include "types.h"
+#include "process.h"
+
+#ifndef KERNEL_STACK_H_INCLUDED
+#define KERNEL_STACK_H_INCLUDED
+
+#ifdef USE_STACK_MONITOR
+
+/** \def STACK_PAINT
+ * Value that free stack memory is painted with at boot.
+ */
+#define STACK_PAINT 0xC5
+
+/** \def STACK_GUARD_SIZE
+ * Count of bytes on the bottom of the stack, that should never be used. When
+ * any of them is overwritten, guard is touched.
+ */
+#ifndef STACK_GUARD_SIZE
+#define STACK_GUARD_SIZE 16
+#endif
+
+/** \def STACK_SCAN_WINDOW
+ * Count of painted bytes below the deepest known stack use, that check_stack
+ * looks through after every worker. Bigger window finds holes in stack frames
+ * (for example not used arrays), but costs more time.
+ */
+#ifndef STACK_SCAN_WINDOW
+#define STACK_SCAN_WINDOW 8
+#endif
+
+/** \def STACK_UNKNOWN_PROCESS
+ * Returned as deepest process when deepest use was found by full scan, not
+ * right after a worker.
+ */
+#define STACK_UNKNOWN_PROCESS PROCESS_HEAP_SIZE
+
+/** \struct stack_monitor_t
+ * This struct stores state of the stack monitor.
+ */
+typedef struct {
+
+    /* Deepest overwritten byte of stack */
+    uint8_t *low_water;
+
+    /* Most bytes of stack used at once */
+    uint16_t max_usage;
+
+    /* Process which was running when max usage was found */
+    pid_t deepest_process;
+
+    /* Guard zone has been overwritten */
+    bool guard_touched;
+
+} stack_monitor_t;
+
+/** \var stack_monitor
+ * Stack monitor of the system.
+ */
+extern stack_monitor_t stack_monitor;
+
+/** \fn stack_monitor_init
+ * This function prepares stack monitor, it must be called after platform
+ * initialization, when stack is already painted.
+ */
+void stack_monitor_init(void);
+
+/** \fn check_stack
+ * This function is called by scheduler after every worker. It looks for new
+ * deepest stack use and checks guard zone. Return PANIC_STATE when guard
+ * was touched and STACK_GUARD_PANIC is set, or GOOD_STATE.
+ */
+exec_state_t check_stack(void);
+
+/** \fn scan_stack_usage
+ * This function scans whole painted memory from bottom, it is slow, but it
+ * finds deepest use even behind holes bigger than STACK_SCAN_WINDOW. Return
+ * most bytes of stack used at once.
+ */
+uint16_t scan_stack_usage(void);
+
+/** \fn get_stack_max_usage
+ * This function returns most bytes of stack used at once, that was found.
+ */
+static inline uint16_t get_stack_max_usage(void) {
+    return stack_monitor.max_usage;
+}
+
+/** \fn get_stack_deepest_process
+ * This function returns PID of process which was running when deepest stack
+ * use was found, or STACK_UNKNOWN_PROCESS.
+ */
+static inline pid_t get_stack_deepest_process(void) {
+    return stack_monitor.deepest_process;
+}
+
+/** \fn is_stack_guard_touched
+ * This function returns true when guard zone on bottom of stack has been
+ * overwritten.
+ */
+static inline bool is_stack_guard_touched(void) {
+    return stack_monitor.guard_touched;
+}
+
+#endif
+
+#endif
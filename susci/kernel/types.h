@@ -48,6 +48,19 @@ typedef enum {
 #define nullptr 0x00
 #endif
 
+/** \def compiler_barrier
+ * Stops compiler from moving memory access across it. It is used where data
+ * is shared with interrupts without disabling them.
+ */
+#define compiler_barrier() __asm__ __volatile__ ("" ::: "memory")
+
+/** \def compile_time_check
+ * Expands to 0 when constant condition is true, else compilation fails. It
+ * can be used inside initializers, for example in DECLARE macros.
+ */
+#define compile_time_check(condition) \
+    (0 * sizeof(char[(condition) ? 1 : -1]))
+
 /** \typedef pid_t
  * System process id
  */
@@ -58,4 +71,14 @@ typedef uint8_t pid_t;
  */
 typedef uint8_t signal_t;
 
+/** \def DRIVER_SIGNALS_FIRST
+ * First signal reserved for drivers, for example PINCHANGE_SIGNAL.
+ */
+#define DRIVER_SIGNALS_FIRST 0x20
+
+/** \def DRIVER_SIGNALS_LAST
+ * Last signal reserved for drivers.
+ */
+#define DRIVER_SIGNALS_LAST 0x5F
+
 #endif
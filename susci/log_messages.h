@@ -0,0 +1,15 @@
+/*
+ * This file stores messages of binary log, used when USE_LOG is set. Every
+ * message has name, that is its id in code, and printf like format, that is
+ * used only by tools/log_decoder.py on the host, so it costs no flash. Add
+ * Your messages at the end, id of message is its position in this list.
+ *
+ * Arguments are raw little endian values, format tells their sizes:
+ *  %c %hhu %hhd %hhx is 1 byte
+ *  %u %d %x is 2 bytes
+ *  %lu %ld %lx is 4 bytes
+ */
+
+LOG_MESSAGE(LOG_BOOT, "boot")
+LOG_MESSAGE(LOG_PANIC, "panic")
+LOG_MESSAGE(LOG_VALUE, "value %u")
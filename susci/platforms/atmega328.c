@@ -21,6 +21,10 @@
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#include "../drivers/integrated/adc.h"
+#include "../drivers/integrated/hardware_uart.h"
 
 /** \fn platform_init
  * This function is responsible for preparing the platform for the operating
@@ -52,6 +56,64 @@ system_tick_t get_time(void) {
     return current_time;
 }
 
+/** \fn platform_idle
+ * This function is called by loader when no process did any work. With
+ * USE_ADC_NOISE_SLEEP, when quiet ADC conversion waits, it sleeps in ADC
+ * noise reduction mode, that starts conversion, and ADC interrupt wakes it
+ * up. Note that system timer and uart are stopped while sleeping, so
+ * system time is late by time of conversion, and while uart sends or
+ * receives message conversion is started without sleep.
+ */
+void platform_idle(void) {
+#ifdef USE_AVR_ADC_NOISE_SLEEP
+    bool can_sleep = true;
+
+    set_sleep_mode(SLEEP_MODE_ADC);
+
+    /* Interrupt between check and sleep would be missed, so sei is last */
+    cli();
+
+#ifdef USE_AVR_HARDWARE_UART
+    can_sleep = is_hardware_uart_idle();
+#endif
+
+    if (!begin_quiet_adc_sleep(can_sleep)) {
+        sei();
+
+        return;
+    }
+
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+#endif
+}
+
+/** \fn platform_lock
+ * This function pauses interrupts and returns previous interrupt state, that
+ * must be given to platform_unlock. Code between them is atomic, also when
+ * it is called from interrupt.
+ */
+uint8_t platform_lock(void) {
+    uint8_t sreg = SREG;
+
+    cli();
+
+    return sreg;
+}
+
+/** \fn platform_unlock
+ * This function restores interrupt state returned by platform_lock.
+ * @state Interrupt state from platform_lock
+ */
+void platform_unlock(uint8_t state) {
+    /* Stores of locked code must not move past interrupt enable */
+    compiler_barrier();
+
+    SREG = state;
+}
+
 /* Catch bad ISR so no reset occurs */
 ISR (BADISR_vect) {}
 
@@ -32,6 +32,10 @@
 #define USE_AVR_PINS
 #endif
 
+#ifdef USE_STACK_MONITOR
+#define USE_AVR_STACK_MONITOR
+#endif
+
 #ifdef USE_PINCHANGE
 #define USE_AVR_PINCHANGE
 #endif
@@ -48,17 +52,26 @@
 #define USE_AVR_ADC
 #endif
 
+#if defined(USE_ADC) && defined(USE_ADC_SCAN)
+#define USE_AVR_ADC_SCAN
+#endif
+
+#if defined(USE_ADC) && defined(USE_ADC_NOISE_SLEEP)
+#define USE_AVR_ADC_NOISE_SLEEP
+#endif
+
 /* Define values for this platform */
 #define TICK_TIME(X) ((system_tick_t)((X) * ((F_CPU) / 1000) / 1024))
 
-#ifdef USE_PINS
+#if defined(USE_PINS) || defined(USE_PINCHANGE)
 #define LOW_DDR (&DDRB)
 #define LOW_PIN (&PINB)
 #define LOW_PORT (&PORTB)
+#define PORTS_COUNT 3
 #endif
 
 #ifdef USE_PINCHANGE
-#define LOW_PCMSK (&PCMSK2)
+#define LOW_PCMSK (&PCMSK0)
 #define GIMSK PCICR
 #endif
 
@@ -113,6 +126,15 @@
 #define MAX_MUX_4
 #endif
 
+#if defined(USE_ADC) && defined(USE_ADC_SCAN)
+#define ADC_SCAN_COMPARE OCR1B
+#define ADC_SCAN_MASK TIMSK1
+#define ADC_SCAN_ENABLE OCIE1B
+#define ADC_SCAN_FLAGS TIFR1
+#define ADC_SCAN_FLAG OCF1B
+#define ADC_SCAN_vect TIMER1_COMPB_vect
+#endif
+
 #ifdef USE_HARDWARE_UART
 #define UCSRB UCSR0B
 #define RXCIE RXCIE0
@@ -122,12 +144,23 @@
 #define UCSZ1 UCSZ01
 #define UDR UDR0
 #define UDRE UDRE0
+#define UDRIE UDRIE0
 #define UCSRA UCSR0A
+#define TXC TXC0
+#define RXC RXC0
+#define U2X U2X0
+#define MPCM MPCM0
 #define USART_RXC_vect USART_RX_vect
 #define UBRRL UBRR0L
 #define UBRRH UBRR0H
 #define UCSRC UCSR0C
 #define URSEL UCSZ0
+#define UART_IDLE_COMPARE OCR1A
+#define UART_IDLE_MASK TIMSK1
+#define UART_IDLE_ENABLE OCIE1A
+#define UART_IDLE_FLAGS TIFR1
+#define UART_IDLE_FLAG OCF1A
+#define UART_IDLE_vect TIMER1_COMPA_vect
 #endif
 
 #endif
@@ -52,6 +52,37 @@ system_tick_t get_time(void) {
     return current_time;
 }
 
+/** \fn platform_idle
+ * This function is called by loader when no process did any work. Platform
+ * can sleep here, but only when interrupt that wakes it up is sure to come,
+ * because system timer has no interrupt.
+ */
+void platform_idle(void) {}
+
+/** \fn platform_lock
+ * This function pauses interrupts and returns previous interrupt state, that
+ * must be given to platform_unlock. Code between them is atomic, also when
+ * it is called from interrupt.
+ */
+uint8_t platform_lock(void) {
+    uint8_t sreg = SREG;
+
+    cli ();
+
+    return sreg;
+}
+
+/** \fn platform_unlock
+ * This function restores interrupt state returned by platform_lock.
+ * @state Interrupt state from platform_lock
+ */
+void platform_unlock(uint8_t state) {
+    /* Stores of locked code must not move past interrupt enable */
+    compiler_barrier();
+
+    SREG = state;
+}
+
 /* Catch bad ISR so no reset occurs */
 ISR (BADISR_vect) {}
 
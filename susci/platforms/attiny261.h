@@ -32,6 +32,10 @@
 #define USE_AVR_PINS
 #endif
 
+#ifdef USE_STACK_MONITOR
+#define USE_AVR_STACK_MONITOR
+#endif
+
 #ifdef USE_PINCHANGE
 #define USE_AVR_PINCHANGE
 #endif
@@ -65,7 +69,8 @@
 #define LOW_DDR &DDRB
 #define LOW_PIN &PINB
 #define LOW_PORT &PORTB
-#define LOW_PCMSK &PCMSK1
+#define PORTS_COUNT 2
+#define LOW_PCMSK (&PCMSK1)
 
 #ifdef DIP_LAYOUT
 #define PIN_1 0
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores stack painting for all AVR platforms. Stack on AVR grows
+ * down from RAMEND, to the end of .bss section.
+ */
+
+#include "../settings.h"
+#include "../kernel/types.h"
+#include "../kernel/platform.h"
+#include "../kernel/stack.h"
+#include "avr.h"
+
+#ifdef USE_AVR_STACK_MONITOR
+
+#include <avr/io.h>
+
+/** \var __heap_start
+ * End of .bss section, set by linker.
+ */
+extern uint8_t __heap_start;
+
+/** \fn paint_stack
+ * This function paints all free memory with STACK_PAINT. It is placed in the
+ * .init3 section, so it runs before main, when nothing is on stack yet. It
+ * must be naked, because init sections are not called, but fall through.
+ */
+void paint_stack(void) __attribute__((naked, used, section(".init3")));
+
+void paint_stack(void) {
+    uint8_t *position = &__heap_start;
+
+    while (position <= (uint8_t *) RAMEND) *position++ = STACK_PAINT;
+}
+
+/** \fn get_stack_bottom
+ * This function returns lowest address that stack can grow to. Memory from
+ * it to the top of stack must be painted with STACK_PAINT at boot.
+ */
+uint8_t *get_stack_bottom(void) {
+    return &__heap_start;
+}
+
+/** \fn get_stack_top
+ * This function returns highest address of stack.
+ */
+uint8_t *get_stack_top(void) {
+    return (uint8_t *) RAMEND;
+}
+
+#endif
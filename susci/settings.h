@@ -6,26 +6,69 @@
  */
 #define PROCESS_HEAP_SIZE 4
 
-/** \def BUFFER_SIZE
- * Set default buffer size 
+/** \def USE_LOAD_MONITOR
+ * Uncomment if You want to measure CPU load of the system.
  */
-#define BUFFER_SIZE 8
+//#define USE_LOAD_MONITOR
 
-/** \def CIRCULAR_BUFFER_SIZE
- * Set default circular buffer size.
+/** \def USE_STACK_MONITOR
+ * Uncomment if You want to monitor deepest use of the stack.
  */
-#define CIRCULAR_BUFFER_SIZE 8
+//#define USE_STACK_MONITOR
 
-/** \def SHARED_MEMORY_SIZE 
- * Shared memory size in bytes.
+/** \def STACK_GUARD_PANIC
+ * Uncomment if You want to call susci_panic when stack guard zone has been
+ * overwritten. It works only with USE_STACK_MONITOR.
  */
-#define SHARED_MEMORY_SIZE 8
+//#define STACK_GUARD_PANIC
+
+/** \def USE_SCRATCH
+ * Uncomment if You want to use scratch arena, shared by all workers.
+ */
+//#define USE_SCRATCH
+
+/** \def SCRATCH_SIZE
+ * Size of scratch arena in bytes, it works only with USE_SCRATCH.
+ */
+#define SCRATCH_SIZE 64
 
 /** \def USE_HARDWARE_UART
  * Uncomment if You want to use hardware uart.
  */
 //#define USE_HARDWARE_UART
 
+/** \def UART_TX_SIZE
+ * Size of hardware uart transmit buffer, it must be power of two, up to 128.
+ */
+#define UART_TX_SIZE 16
+
+/** \def UART_RX_SIZE
+ * Size of hardware uart receive buffer, it must be power of two, up to 128.
+ */
+#define UART_RX_SIZE 16
+
+/** \def UART_RX_DELIMITER
+ * Uncomment if You want to wake up uart receiver when this char comes.
+ */
+//#define UART_RX_DELIMITER '\n'
+
+/** \def USE_FRAME
+ * Uncomment if You want to send and receive frames with CRC, for example
+ * through hardware uart.
+ */
+//#define USE_FRAME
+
+/** \def USE_LOG
+ * Uncomment if You want to use binary log through hardware uart, messages
+ * are listed in log_messages.h.
+ */
+//#define USE_LOG
+
+/** \def LOG_SIZE
+ * Size of binary log buffer, it must be power of two, up to 128.
+ */
+#define LOG_SIZE 32
+
 /** \def USE_PINS
  * Uncomment if You want to use pins.
  */
@@ -46,6 +89,31 @@
  */
 //#define USE_ADC
 
+/** \def USE_ADC_SCAN
+ * Uncomment if You want to scan list of ADC channels from interrupt, it
+ * works only with USE_ADC.
+ */
+//#define USE_ADC_SCAN
+
+/** \def USE_ADC_FILTER
+ * Uncomment if You want to filter ADC samples with fixed point pipeline.
+ */
+//#define USE_ADC_FILTER
+
+/** \def USE_ADC_NOISE_SLEEP
+ * Uncomment if You want CPU to sleep in ADC noise reduction mode during
+ * quiet ADC conversions. It stops uart and system timer, so it is skipped
+ * while uart sends or receives message, then conversion runs without
+ * sleep. Char that starts during sleep is lost, and system time and timer
+ * compare interrupts are late by time of conversion.
+ */
+//#define USE_ADC_NOISE_SLEEP
+
+/** \def ADC_SCAN_MAX_CHANNELS
+ * Most ADC channels in one scan.
+ */
+#define ADC_SCAN_MAX_CHANNELS 6
+
 /** \def TYPE_LAYOUT
  * Your MCU package configuration for PIN_x macros.
  */
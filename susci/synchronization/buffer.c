@@ -14,7 +14,6 @@
  * functions responsibles for working with standard system Buffer.
  */
 
-#include "../settings.h"
 #include "../kernel/types.h"
 #include "buffer.h"
 
@@ -42,3 +41,76 @@ bool write_buffer(buffer_t *buffer, char data) {
     
     return true;
 }
+
+/** \fn read_buffer_span
+ * Read up to given count of bytes from buffer to given memory. Return count
+ * of bytes read.
+ * @*buffer: Buffer object
+ * @*data: Memory to read to
+ * @length: Max count of bytes to read
+ */
+uint8_t read_buffer_span(buffer_t *buffer, char *data, uint8_t length) {
+    length = peek_buffer_span(buffer, data, length);
+
+    return skip_buffer(buffer, length);
+}
+
+/** \fn peek_buffer_span
+ * Copy up to given count of bytes from buffer to given memory, but not
+ * remove them from buffer. Return count of bytes copied.
+ * @*buffer: Buffer object
+ * @*data: Memory to copy to
+ * @length: Max count of bytes to copy
+ */
+uint8_t peek_buffer_span(buffer_t *buffer, char *data, uint8_t length) {
+    uint8_t count = get_buffer_count(buffer);
+
+    if (length > count) length = count;
+
+    const char *source = buffer->buffer + buffer->read_position;
+    const char *end = source + length;
+
+    while (source != end) *data++ = *source++;
+
+    return length;
+}
+
+/** \fn skip_buffer
+ * Remove up to given count of bytes from buffer without reading them.
+ * Return count of bytes removed.
+ * @*buffer: Buffer object
+ * @length: Max count of bytes to remove
+ */
+uint8_t skip_buffer(buffer_t *buffer, uint8_t length) {
+    uint8_t count = get_buffer_count(buffer);
+
+    if (length > count) length = count;
+
+    buffer->read_position += length;
+
+    if (all_data_read_from_buffer(buffer)) reset_buffer(buffer);
+
+    return length;
+}
+
+/** \fn write_buffer_span
+ * Write as much bytes from given memory as fits into buffer. Return count
+ * of bytes written.
+ * @*buffer: Buffer object
+ * @*data: Memory to write from
+ * @length: Count of bytes to write
+ */
+uint8_t write_buffer_span(buffer_t *buffer, const char *data, uint8_t length) {
+    uint8_t free = get_buffer_free(buffer);
+
+    if (length > free) length = free;
+
+    char *target = buffer->buffer + buffer->write_position;
+    char *end = target + length;
+
+    while (target != end) *target++ = *data++;
+
+    buffer->write_position += length;
+
+    return length;
+}
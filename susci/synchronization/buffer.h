@@ -14,7 +14,6 @@
  * functions responsibles for working with standard system Buffer.
  */
 
-#include "../settings.h"
 #include "../kernel/types.h"
 
 #ifndef SYNCHRONIZATION_BUFFER_H_INCLUDED
@@ -31,16 +30,36 @@ typedef struct {
     /* Writer position in buffer */
     uint8_t write_position;
 
+    /* Size of memory for buffer in bytes */
+    uint8_t size;
+
     /* Memory for buffer */
-    char buffer[BUFFER_SIZE];
+    char *buffer;
 
 } buffer_t;
 
+/** \def DECLARE_BUFFER
+ * Declares empty buffer with given name, and memory for it, for given count
+ * of elements of given type. Memory is named name_area. Buffer still stores
+ * chars, so its size in bytes is capacity * sizeof(type). Compilation fails
+ * when size of memory is bigger than 255 bytes.
+ */
+#define DECLARE_BUFFER(name, type, capacity) \
+    type name##_area[capacity]; \
+    buffer_t name = { \
+        0x00, \
+        0x00, \
+        sizeof(name##_area) + compile_time_check(sizeof(name##_area) <= 255), \
+        (char *) name##_area \
+    }
+
 /** \fn create_buffer
- * This function creating empty buffer and returning it.
+ * This function creating empty buffer on given memory and returning it.
+ * @*area Memory for buffer
+ * @size Size of memory in bytes
  */
-static inline buffer_t create_buffer() {
-    return (buffer_t) {0x00, 0x00, {0x00}};
+static inline buffer_t create_buffer(char *area, uint8_t size) {
+    return (buffer_t) {0x00, 0x00, size, area};
 }
 
 /** \fn is_buffer_readable
@@ -56,7 +75,7 @@ static inline bool is_buffer_readable(buffer_t *buffer) {
  * @*buffer Buffer object
  */
 static inline bool is_buffer_writable(buffer_t *buffer) {
-    return (bool) (buffer->write_position <= BUFFER_SIZE);
+    return (bool) (buffer->write_position < buffer->size);
 }
 
 /** \fn all_data_read_from_buffer
@@ -66,6 +85,22 @@ static inline bool all_data_read_from_buffer(buffer_t *buffer) {
     return (bool) (buffer->read_position == buffer->write_position);
 }
 
+/** \fn get_buffer_count
+ * Return count of bytes that can be read from buffer.
+ * @*buffer Buffer object
+ */
+static inline uint8_t get_buffer_count(buffer_t *buffer) {
+    return (uint8_t) (buffer->write_position - buffer->read_position);
+}
+
+/** \fn get_buffer_free
+ * Return count of bytes that can be written to buffer.
+ * @*buffer Buffer object
+ */
+static inline uint8_t get_buffer_free(buffer_t *buffer) {
+    return (uint8_t) (buffer->size - buffer->write_position);
+}
+
 /** \fn reset_buffer
  * This reset buffer for writing new data.
  */
@@ -86,4 +121,65 @@ char read_buffer(buffer_t *buffer);
  */
 bool write_buffer(buffer_t *buffer, char data);
 
+/** \fn read_buffer_span
+ * Read up to given count of bytes from buffer to given memory. Return count
+ * of bytes read.
+ * @*buffer: Buffer object
+ * @*data: Memory to read to
+ * @length: Max count of bytes to read
+ */
+uint8_t read_buffer_span(buffer_t *buffer, char *data, uint8_t length);
+
+/** \fn peek_buffer_span
+ * Copy up to given count of bytes from buffer to given memory, but not
+ * remove them from buffer. Return count of bytes copied.
+ * @*buffer: Buffer object
+ * @*data: Memory to copy to
+ * @length: Max count of bytes to copy
+ */
+uint8_t peek_buffer_span(buffer_t *buffer, char *data, uint8_t length);
+
+/** \fn skip_buffer
+ * Remove up to given count of bytes from buffer without reading them.
+ * Return count of bytes removed.
+ * @*buffer: Buffer object
+ * @length: Max count of bytes to remove
+ */
+uint8_t skip_buffer(buffer_t *buffer, uint8_t length);
+
+/** \fn write_buffer_span
+ * Write as much bytes from given memory as fits into buffer. Return count
+ * of bytes written.
+ * @*buffer: Buffer object
+ * @*data: Memory to write from
+ * @length: Count of bytes to write
+ */
+uint8_t write_buffer_span(buffer_t *buffer, const char *data, uint8_t length);
+
+/** \def read_buffer_element
+ * Read element of any type from buffer to given variable. Nothing is read
+ * and false is returned, when buffer has not whole element.
+ * @*buffer: Buffer object
+ * @element: Variable to read to
+ */
+#define read_buffer_element(buffer, element) \
+    ((bool) ( \
+        get_buffer_count(buffer) >= sizeof(element) \
+        && read_buffer_span(buffer, (char *) &(element), sizeof(element)) \
+    ))
+
+/** \def write_buffer_element
+ * Write element of any type from given variable to buffer. Nothing is
+ * written and false is returned, when whole element does not fit.
+ * @*buffer: Buffer object
+ * @element: Variable to write from
+ */
+#define write_buffer_element(buffer, element) \
+    ((bool) ( \
+        get_buffer_free(buffer) >= sizeof(element) \
+        && write_buffer_span( \
+            buffer, (const char *) &(element), sizeof(element) \
+        ) \
+    ))
+
 #endif
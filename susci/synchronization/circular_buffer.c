@@ -14,7 +14,7 @@
  * functions responsibles for CircularBuffer in system.
  */
 
-#include "../settings.h"
+#include "../kernel/types.h"
 #include "circular_buffer.h"
 
 /** \fn write_circular_buffer
@@ -24,7 +24,8 @@
  */
 void write_circular_buffer(circular_buffer_t *buffer, char data) {
     buffer->buffer[buffer->write_position++] = data;
-    buffer->write_position %= CIRCULAR_BUFFER_SIZE;
+
+    if (buffer->write_position == buffer->size) buffer->write_position = 0;
 }
 
 /** \fn read_circulat_buffer
@@ -34,7 +35,7 @@ void write_circular_buffer(circular_buffer_t *buffer, char data) {
 char read_circular_buffer(circular_buffer_t *buffer) {
     char data = buffer->buffer[buffer->read_position++];
     
-    buffer->read_position %= CIRCULAR_BUFFER_SIZE;
+    if (buffer->read_position == buffer->size) buffer->read_position = 0;
 
     return data;
 }
@@ -14,7 +14,6 @@
  * functions responsibles for CircularBuffer in system.
  */
 
-#include "../settings.h"
 #include "../kernel/types.h"
 
 #ifndef SYNCHRONIZATION_CIRCULAR_BUFFER_H_INCLUDED
@@ -31,16 +30,40 @@ typedef struct {
     /* Writer position */
     uint8_t write_position;
 
-    /* Alocate memory for circular buffer */
-    char buffer[CIRCULAR_BUFFER_SIZE];
+    /* Size of memory for circular buffer in bytes */
+    uint8_t size;
+
+    /* Memory for circular buffer */
+    char *buffer;
 
 } circular_buffer_t;
 
+/** \def DECLARE_CIRCULAR_BUFFER
+ * Declares empty circular buffer with given name, and memory for it, for
+ * given count of elements of given type. Memory is named name_area. Buffer
+ * still stores chars, so its size in bytes is capacity * sizeof(type).
+ * Compilation fails when size of memory is bigger than 255 bytes.
+ */
+#define DECLARE_CIRCULAR_BUFFER(name, type, capacity) \
+    type name##_area[capacity]; \
+    circular_buffer_t name = { \
+        0x00, \
+        0x00, \
+        sizeof(name##_area) + compile_time_check(sizeof(name##_area) <= 255), \
+        (char *) name##_area \
+    }
+
 /** \fn create_circular_buffer
- * This function creating empty circular buffer and returning it.
+ * This function creating empty circular buffer on given memory and
+ * returning it.
+ * @*area Memory for circular buffer
+ * @size Size of memory in bytes
  */
-static inline circular_buffer_t create_circular_buffer(void) {
-    return (circular_buffer_t) {0x00, 0x00, {0x00}};
+static inline circular_buffer_t create_circular_buffer(
+    char *area,
+    uint8_t size
+) {
+    return (circular_buffer_t) {0x00, 0x00, size, area};
 }
 
 /** \fn write_circular_buffer
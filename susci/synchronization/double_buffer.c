@@ -0,0 +1,69 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores declarations and definitions of data structures and
+ * functions responsibles for DoubleBuffer in system. DoubleBuffer has two
+ * halves, producer (usually interrupt) fills one of them while consumer
+ * process reads other one, then they are swapped by changing pointers, so
+ * no data is copied.
+ */
+
+#include "../kernel/types.h"
+#include "../kernel/interface.h"
+#include "double_buffer.h"
+
+/** \fn swap_double_buffer
+ * Give filled half to consumer and make signal, it is called by producer,
+ * for example at end of frame. Return false when consumer has not released
+ * its half yet, or there is nothing to give.
+ * @*buffer: DoubleBuffer object
+ */
+bool swap_double_buffer(double_buffer_t *buffer) {
+    if (buffer->read_length != 0x00) return false;
+    if (buffer->write_position == 0x00) return false;
+
+    char *filled = buffer->write_half;
+
+    buffer->write_half = buffer->read_half;
+    buffer->read_half = filled;
+
+    /* Half must be swapped before consumer can see its length */
+    compiler_barrier();
+    buffer->read_length = buffer->write_position;
+    buffer->write_position = 0x00;
+
+    if (buffer->signal != 0x00) make_signal(buffer->signal);
+
+    return true;
+}
+
+/** \fn write_double_buffer
+ * Write new data to half owned by producer, and swap halves when it is
+ * full. Return false when both halves are full, and data has been lost.
+ * @*buffer: DoubleBuffer object
+ * @data: New data to write
+ */
+bool write_double_buffer(double_buffer_t *buffer, char data) {
+    /* Half has been filled, but consumer did not release other one */
+    if (buffer->write_position == buffer->size) {
+        if (!swap_double_buffer(buffer)) {
+            if (buffer->overruns != 0xFF) ++ buffer->overruns;
+            return false;
+        }
+    }
+
+    buffer->write_half[buffer->write_position++] = data;
+
+    if (buffer->write_position == buffer->size) swap_double_buffer(buffer);
+
+    return true;
+}
@@ -0,0 +1,167 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores declarations and definitions of data structures and
+ * functions responsibles for DoubleBuffer in system. DoubleBuffer has two
+ * halves, producer (usually interrupt) fills one of them while consumer
+ * process reads other one, then they are swapped by changing pointers, so
+ * no data is copied.
+ */
+
+#include "../kernel/types.h"
+
+#ifndef SYNCHRONIZATION_DOUBLE_BUFFER_H_INCLUDED
+#define SYNCHRONIZATION_DOUBLE_BUFFER_H_INCLUDED
+
+/** \struct double_buffer_t
+ * Struct for double buffer.
+ */
+typedef struct {
+
+    /* Half filled by producer */
+    char *write_half;
+
+    /* Half read by consumer */
+    char *read_half;
+
+    /* Size of one half in bytes */
+    uint8_t size;
+
+    /* Writer position in write half, changed only by producer */
+    volatile uint8_t write_position;
+
+    /* Count of data in read half, zero when consumer released it */
+    volatile uint8_t read_length;
+
+    /* Signal made after swap, 0x00 when none */
+    signal_t signal;
+
+    /* Count of data lost, because both halves were full, up to 255 */
+    volatile uint8_t overruns;
+
+} double_buffer_t;
+
+/** \def DECLARE_DOUBLE_BUFFER
+ * Declares empty double buffer with given name, and memory for it, for
+ * given count of elements of given type in every half. Memory is named
+ * name_area. Given signal is made after every swap. Compilation fails when
+ * half is bigger than 255 bytes.
+ */
+#define DECLARE_DOUBLE_BUFFER(name, type, capacity, signal) \
+    type name##_area[2][capacity]; \
+    double_buffer_t name = { \
+        (char *) name##_area[0], \
+        (char *) name##_area[1], \
+        sizeof(name##_area[0]) + compile_time_check( \
+            sizeof(name##_area[0]) <= 255 \
+        ), \
+        0x00, \
+        0x00, \
+        signal, \
+        0x00 \
+    }
+
+/** \fn create_double_buffer
+ * This function creating empty double buffer on given memory and returning
+ * it. Memory is split into two halves, every half is at most 255 bytes,
+ * rest of bigger memory is not used.
+ * @*area Memory for double buffer
+ * @size Size of memory in bytes
+ * @signal Signal made after every swap, 0x00 when none
+ */
+static inline double_buffer_t create_double_buffer(
+    char *area,
+    uint16_t size,
+    signal_t signal
+) {
+    uint8_t half = size / 2 > 0xFF ? 0xFF : (uint8_t) (size / 2);
+
+    return (double_buffer_t) {
+        area, area + half, half, 0x00, 0x00, signal, 0x00
+    };
+}
+
+/** \fn is_double_buffer_readable
+ * Return true when consumer has half with data to read.
+ * @*buffer: DoubleBuffer object
+ */
+static inline bool is_double_buffer_readable(double_buffer_t *buffer) {
+    bool readable = (bool) (buffer->read_length != 0x00);
+
+    /* Data must not be read before its length */
+    compiler_barrier();
+
+    return readable;
+}
+
+/** \fn get_double_buffer_length
+ * Return count of data in half owned by consumer.
+ * @*buffer: DoubleBuffer object
+ */
+static inline uint8_t get_double_buffer_length(double_buffer_t *buffer) {
+    uint8_t length = buffer->read_length;
+
+    /* Data must not be read before its length */
+    compiler_barrier();
+
+    return length;
+}
+
+/** \fn get_double_buffer_data
+ * Return half owned by consumer, it is valid until release_double_buffer
+ * is called. Must first check if double buffer is readable.
+ * @*buffer: DoubleBuffer object
+ */
+static inline const char *get_double_buffer_data(double_buffer_t *buffer) {
+    /* Half must not be read before length was checked */
+    compiler_barrier();
+
+    return buffer->read_half;
+}
+
+/** \fn release_double_buffer
+ * Give half owned by consumer back to producer, after all data in it has
+ * been processed.
+ * @*buffer: DoubleBuffer object
+ */
+static inline void release_double_buffer(double_buffer_t *buffer) {
+    /* Consumer must be done with data before producer can see it free */
+    compiler_barrier();
+    buffer->read_length = 0x00;
+}
+
+/** \fn get_double_buffer_overruns
+ * Return count of data lost, because both halves were full. It stops at
+ * 255, so it never wraps back to zero.
+ * @*buffer: DoubleBuffer object
+ */
+static inline uint8_t get_double_buffer_overruns(double_buffer_t *buffer) {
+    return buffer->overruns;
+}
+
+/** \fn swap_double_buffer
+ * Give filled half to consumer and make signal, it is called by producer,
+ * for example at end of frame. Return false when consumer has not released
+ * its half yet, or there is nothing to give.
+ * @*buffer: DoubleBuffer object
+ */
+bool swap_double_buffer(double_buffer_t *buffer);
+
+/** \fn write_double_buffer
+ * Write new data to half owned by producer, and swap halves when it is
+ * full. Return false when both halves are full, and data has been lost.
+ * @*buffer: DoubleBuffer object
+ * @data: New data to write
+ */
+bool write_double_buffer(double_buffer_t *buffer, char data);
+
+#endif
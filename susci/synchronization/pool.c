@@ -0,0 +1,68 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores declarations and definitions of data structures and
+ * functions responsibles for Pool in system. Pool gives and takes back blocks
+ * of one size in constant time, so messages, frames or requests with
+ * different lifetime can share one memory, instead of memory for worst case
+ * in every place. Blocks can be given back from interrupts.
+ */
+
+#include "../kernel/types.h"
+#include "../kernel/platform.h"
+#include "pool.h"
+
+/** \fn allocate_pool
+ * This function takes block from pool and returns it, or returns nullptr
+ * when all blocks are given. It is safe to call it from interrupt.
+ * @*pool Pool object
+ */
+void *allocate_pool(pool_t *pool) {
+    void *block = nullptr;
+    uint8_t state = platform_lock();
+
+    if (pool->free != nullptr) {
+        block = pool->free;
+        pool->free = *(void **) block;
+    } else if (pool->fresh < pool->end) {
+        block = pool->fresh;
+        pool->fresh += pool->block_size;
+    }
+
+    if (block == nullptr) {
+        if (pool->failures != 0xFF) ++ pool->failures;
+    } else if (++ pool->used > pool->high_water) {
+        pool->high_water = pool->used;
+    }
+
+    platform_unlock(state);
+
+    return block;
+}
+
+/** \fn free_pool
+ * This function gives block back to pool. Block must be taken from the same
+ * pool. It is safe to call it from interrupt.
+ * @*pool Pool object
+ * @*block Block to give back
+ */
+void free_pool(pool_t *pool, void *block) {
+    if (block == nullptr) return;
+
+    uint8_t state = platform_lock();
+
+    *(void **) block = pool->free;
+    pool->free = block;
+    -- pool->used;
+
+    platform_unlock(state);
+}
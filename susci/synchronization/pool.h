@@ -0,0 +1,148 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores declarations and definitions of data structures and
+ * functions responsibles for Pool in system. Pool gives and takes back blocks
+ * of one size in constant time, so messages, frames or requests with
+ * different lifetime can share one memory, instead of memory for worst case
+ * in every place. Blocks can be given back from interrupts.
+ */
+
+#include "../kernel/types.h"
+
+#ifndef SYNCHRONIZATION_POOL_H_INCLUDED
+#define SYNCHRONIZATION_POOL_H_INCLUDED
+
+/** \struct pool_t
+ * Type for Pool. Free blocks are stored in list, every free block stores
+ * pointer to next one. Blocks that was never given are not in the list, so
+ * pool does not need to be prepared before first use.
+ */
+typedef struct {
+
+    /* First block that has been given back, or nullptr */
+    void *free;
+
+    /* First block that was never given */
+    char *fresh;
+
+    /* End of memory of the pool */
+    char *end;
+
+    /* Size of one block in bytes */
+    uint8_t block_size;
+
+    /* Count of given blocks */
+    uint8_t used;
+
+    /* Most blocks given at once */
+    uint8_t high_water;
+
+    /* Count of allocations that failed because pool was empty */
+    uint8_t failures;
+
+} pool_t;
+
+/** \def DECLARE_POOL
+ * This macro declares pool with given name and memory for given count of
+ * blocks of given type. Memory is named name_area. Every block is at least
+ * as big as pointer, because free block stores pointer to next one.
+ * Compilation fails when block is bigger than 255 bytes, or there are more
+ * than 255 blocks.
+ */
+#define DECLARE_POOL(name, type, capacity) \
+    union { type block; void *next; } name##_area[capacity]; \
+    pool_t name = { \
+        nullptr, \
+        (char *) name##_area, \
+        (char *) name##_area + sizeof(name##_area), \
+        sizeof(name##_area[0]) + compile_time_check( \
+            sizeof(name##_area[0]) <= 255 && (capacity) <= 255 \
+        ), \
+        0x00, \
+        0x00, \
+        0x00 \
+    }
+
+/** \fn create_pool
+ * This function creating empty pool on given memory and returning it. Block
+ * size must be at least size of pointer, and memory must be aligned for type
+ * stored in blocks.
+ * @*area Memory for pool
+ * @block_size Size of one block in bytes
+ * @blocks Count of blocks in memory
+ */
+static inline pool_t create_pool(
+    char *area,
+    uint8_t block_size,
+    uint8_t blocks
+) {
+    return (pool_t) {
+        nullptr,
+        area,
+        area + block_size * blocks,
+        block_size,
+        0x00,
+        0x00,
+        0x00
+    };
+}
+
+/** \fn allocate_pool
+ * This function takes block from pool and returns it, or returns nullptr
+ * when all blocks are given. It is safe to call it from interrupt.
+ * @*pool Pool object
+ */
+void *allocate_pool(pool_t *pool);
+
+/** \fn free_pool
+ * This function gives block back to pool. Block must be taken from the same
+ * pool. It is safe to call it from interrupt.
+ * @*pool Pool object
+ * @*block Block to give back
+ */
+void free_pool(pool_t *pool, void *block);
+
+/** \fn get_pool_used
+ * This function returns count of blocks that are given now.
+ * @*pool Pool object
+ */
+static inline uint8_t get_pool_used(pool_t *pool) {
+    return pool->used;
+}
+
+/** \fn get_pool_high_water
+ * This function returns most blocks that was given at once.
+ * @*pool Pool object
+ */
+static inline uint8_t get_pool_high_water(pool_t *pool) {
+    return pool->high_water;
+}
+
+/** \fn get_pool_failures
+ * This function returns count of allocations that failed, because all
+ * blocks was given.
+ * @*pool Pool object
+ */
+static inline uint8_t get_pool_failures(pool_t *pool) {
+    return pool->failures;
+}
+
+/** \fn get_pool_block_size
+ * This function returns size of one block in bytes.
+ * @*pool Pool object
+ */
+static inline uint8_t get_pool_block_size(pool_t *pool) {
+    return pool->block_size;
+}
+
+#endif
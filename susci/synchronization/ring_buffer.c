@@ -0,0 +1,118 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores declarations and definitions of data structures and
+ * functions responsibles for RingBuffer in system. RingBuffer has one writer
+ * and one reader, for example interrupt and process, and it is safe between
+ * them without disabling interrupts. Unlike CircularBuffer, it never
+ * overwrites data that has not been read.
+ */
+
+#include "../kernel/types.h"
+#include "ring_buffer.h"
+
+/** \fn write_ring_buffer
+ * Write new data to ring buffer. Return false when buffer is full, and data
+ * has not been written.
+ * @*buffer: RingBuffer object
+ * @data: New data for buffer
+ */
+bool write_ring_buffer(ring_buffer_t *buffer, char data) {
+    uint8_t position = buffer->write_position;
+
+    if ((uint8_t) (position - buffer->read_position) > buffer->mask) {
+        return false;
+    }
+
+    buffer->buffer[position & buffer->mask] = data;
+
+    /* Data must be in buffer before reader can see it */
+    compiler_barrier();
+    buffer->write_position = position + 1;
+
+    return true;
+}
+
+/** \fn read_ring_buffer
+ * Return data from ring buffer, must first check if buffer is not empty.
+ * @*buffer: RingBuffer object
+ */
+char read_ring_buffer(ring_buffer_t *buffer) {
+    uint8_t position = buffer->read_position;
+    char data = buffer->buffer[position & buffer->mask];
+
+    /* Data must be read before writer can overwrite it */
+    compiler_barrier();
+    buffer->read_position = position + 1;
+
+    return data;
+}
+
+/** \fn write_ring_buffer_span
+ * Write as much data from given memory as fits into ring buffer. Return
+ * count of written data.
+ * @*buffer: RingBuffer object
+ * @*data: Memory to write from
+ * @length: Count of data to write
+ */
+uint8_t write_ring_buffer_span(
+    ring_buffer_t *buffer,
+    const char *data,
+    uint8_t length
+) {
+    uint8_t position = buffer->write_position;
+    uint8_t mask = buffer->mask;
+    char *area = buffer->buffer;
+    uint8_t free = get_ring_buffer_free(buffer);
+
+    if (length > free) length = free;
+
+    for (uint8_t count = length; count > 0; -- count) {
+        area[position++ & mask] = *data++;
+    }
+
+    /* Publish all written data at once */
+    compiler_barrier();
+    buffer->write_position = position;
+
+    return length;
+}
+
+/** \fn read_ring_buffer_span
+ * Read as much data as is in ring buffer, up to given length, into given
+ * memory. Return count of read data.
+ * @*buffer: RingBuffer object
+ * @*data: Memory to read to
+ * @length: Max count of data to read
+ */
+uint8_t read_ring_buffer_span(
+    ring_buffer_t *buffer,
+    char *data,
+    uint8_t length
+) {
+    uint8_t position = buffer->read_position;
+    uint8_t mask = buffer->mask;
+    char *area = buffer->buffer;
+    uint8_t count = (uint8_t) (buffer->write_position - position);
+
+    if (length > count) length = count;
+
+    for (count = length; count > 0; -- count) {
+        *data++ = area[position++ & mask];
+    }
+
+    /* Release all read data at once */
+    compiler_barrier();
+    buffer->read_position = position;
+
+    return length;
+}
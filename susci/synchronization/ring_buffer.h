@@ -0,0 +1,168 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores declarations and definitions of data structures and
+ * functions responsibles for RingBuffer in system. RingBuffer has one writer
+ * and one reader, for example interrupt and process, and it is safe between
+ * them without disabling interrupts. Unlike CircularBuffer, it never
+ * overwrites data that has not been read.
+ */
+
+#include "../kernel/types.h"
+
+#ifndef SYNCHRONIZATION_RING_BUFFER_H_INCLUDED
+#define SYNCHRONIZATION_RING_BUFFER_H_INCLUDED
+
+/** \struct ring_buffer_t
+ * Struct for ring buffer. Positions are never wrapped, only masked when
+ * used, so difference between them is count of data in buffer. Size of
+ * ring buffer must be power of two, up to 128 bytes.
+ */
+typedef struct {
+
+    /* Writer position, changed only by writer */
+    volatile uint8_t write_position;
+
+    /* Reader position, changed only by reader */
+    volatile uint8_t read_position;
+
+    /* Size of memory for ring buffer in bytes, minus one */
+    uint8_t mask;
+
+    /* Memory for ring buffer */
+    char *buffer;
+
+} ring_buffer_t;
+
+/** \def DECLARE_RING_BUFFER
+ * Declares empty ring buffer with given name, and memory for it, for given
+ * count of elements of given type. Memory is named name_area. Buffer still
+ * stores chars, so its size in bytes is capacity * sizeof(type). Compilation
+ * fails when size of memory is not power of two, up to 128 bytes.
+ */
+#define DECLARE_RING_BUFFER(name, type, capacity) \
+    type name##_area[capacity]; \
+    ring_buffer_t name = { \
+        0x00, \
+        0x00, \
+        sizeof(name##_area) - 1 + compile_time_check( \
+            (sizeof(name##_area) & (sizeof(name##_area) - 1)) == 0 \
+            && sizeof(name##_area) <= 128 \
+        ), \
+        (char *) name##_area \
+    }
+
+/** \fn create_ring_buffer
+ * This function creating empty ring buffer on given memory and returning
+ * it. Size must be power of two, up to 128.
+ * @*area Memory for ring buffer
+ * @size Size of memory in bytes
+ */
+static inline ring_buffer_t create_ring_buffer(char *area, uint8_t size) {
+    return (ring_buffer_t) {0x00, 0x00, (uint8_t) (size - 1), area};
+}
+
+/** \fn get_ring_buffer_size
+ * Return size of ring buffer memory in bytes.
+ * @*buffer: RingBuffer object
+ */
+static inline uint8_t get_ring_buffer_size(ring_buffer_t *buffer) {
+    return (uint8_t) (buffer->mask + 1);
+}
+
+/** \fn get_ring_buffer_count
+ * Return count of data in ring buffer.
+ * @*buffer: RingBuffer object
+ */
+static inline uint8_t get_ring_buffer_count(ring_buffer_t *buffer) {
+    return (uint8_t) (buffer->write_position - buffer->read_position);
+}
+
+/** \fn get_ring_buffer_free
+ * Return count of data that can be written to ring buffer.
+ * @*buffer: RingBuffer object
+ */
+static inline uint8_t get_ring_buffer_free(ring_buffer_t *buffer) {
+    return (uint8_t) (
+        get_ring_buffer_size(buffer) - get_ring_buffer_count(buffer)
+    );
+}
+
+/** \fn is_ring_buffer_empty
+ * Return true when there is nothing to read in ring buffer.
+ * @*buffer: RingBuffer object
+ */
+static inline bool is_ring_buffer_empty(ring_buffer_t *buffer) {
+    return (bool) (buffer->write_position == buffer->read_position);
+}
+
+/** \fn is_ring_buffer_full
+ * Return true when nothing more can be written to ring buffer.
+ * @*buffer: RingBuffer object
+ */
+static inline bool is_ring_buffer_full(ring_buffer_t *buffer) {
+    return (bool) (get_ring_buffer_count(buffer) > buffer->mask);
+}
+
+/** \fn peek_ring_buffer
+ * Return data at given offset from oldest data, without reading it. Count
+ * of data must be checked first, only reader can call it.
+ * @*buffer: RingBuffer object
+ * @offset: Offset from oldest data
+ */
+static inline char peek_ring_buffer(ring_buffer_t *buffer, uint8_t offset) {
+    return buffer->buffer[
+        (uint8_t) (buffer->read_position + offset) & buffer->mask
+    ];
+}
+
+/** \fn write_ring_buffer
+ * Write new data to ring buffer. Return false when buffer is full, and data
+ * has not been written.
+ * @*buffer: RingBuffer object
+ * @data: New data for buffer
+ */
+bool write_ring_buffer(ring_buffer_t *buffer, char data);
+
+/** \fn read_ring_buffer
+ * Return data from ring buffer, must first check if buffer is not empty.
+ * @*buffer: RingBuffer object
+ */
+char read_ring_buffer(ring_buffer_t *buffer);
+
+/** \fn write_ring_buffer_span
+ * Write as much data from given memory as fits into ring buffer. Return
+ * count of written data.
+ * @*buffer: RingBuffer object
+ * @*data: Memory to write from
+ * @length: Count of data to write
+ */
+uint8_t write_ring_buffer_span(
+    ring_buffer_t *buffer,
+    const char *data,
+    uint8_t length
+);
+
+/** \fn read_ring_buffer_span
+ * Read as much data as is in ring buffer, up to given length, into given
+ * memory. Return count of read data.
+ * @*buffer: RingBuffer object
+ * @*data: Memory to read to
+ * @length: Max count of data to read
+ */
+uint8_t read_ring_buffer_span(
+    ring_buffer_t *buffer,
+    char *data,
+    uint8_t length
+);
+
+#endif
@@ -17,7 +17,6 @@
  * a pointer, it's optional.
  */
 
-#include "../settings.h"
 #include "../kernel/types.h"
 #include "shared_memory.h"
 
@@ -26,7 +25,7 @@
  * @*shared Pointer to shared memory for work on it
  */
 void reset_shared_memory_area(shared_memory_t *shared) {
-	for (uint8_t pointer = 0; pointer < SHARED_MEMORY_SIZE; ++ pointer){
+	for (uint8_t pointer = 0; pointer < shared->size; ++ pointer){
 		shared->area[pointer] = 0x00;
     }
 }
@@ -37,7 +36,7 @@ void reset_shared_memory_area(shared_memory_t *shared) {
  * @*shared Pointer to shared memory for work on it
  */
 char read_shared_memory(shared_memory_t *shared) {
-	shared->pointer = shared->pointer % SHARED_MEMORY_SIZE;
+	if (shared->pointer >= shared->size) shared->pointer = 0;
 
 	return shared->area[shared->pointer++];
 }
@@ -49,7 +48,276 @@ char read_shared_memory(shared_memory_t *shared) {
  * @data New data to write
  */
 void write_shared_memory(shared_memory_t *shared, char data) {
-	shared->pointer = shared->pointer % SHARED_MEMORY_SIZE;
+	if (shared->pointer >= shared->size) shared->pointer = 0;
 
-	shared->area[shared->pointer++] = data;
+	uint8_t address = shared->pointer++;
+
+	/* Data must be stored before receiver is signaled */
+	shared->area[address] = data;
+	mark_shared_memory_dirty(shared, address);
+}
+
+/** \fn advance_shared_memory_address
+ * This function returns address moved by given count of bytes, wrapped at
+ * end of shared area.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address to move
+ * @length Count of bytes to move by
+ */
+static inline uint8_t advance_shared_memory_address(
+    shared_memory_t *shared,
+    uint8_t address,
+    uint8_t length
+) {
+	uint8_t left = shared->size - address;
+
+	if (length < left) return address + length;
+
+	return wrap_shared_memory_address(shared, length - left);
+}
+
+/** \fn mark_shared_memory_span_dirty
+ * This function marks dirty all regions with any of given count of bytes,
+ * starting at given address.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address of first byte, in shared area
+ * @length Count of bytes
+ */
+static void mark_shared_memory_span_dirty(
+    shared_memory_t *shared,
+    uint8_t address,
+    uint8_t length
+) {
+	if (shared->dirty == nullptr) return;
+
+	uint8_t region_mask = (uint8_t) ((1 << shared->region_shift) - 1);
+
+	while (length) {
+		mark_shared_memory_dirty(shared, address);
+
+		uint8_t step = (uint8_t) (region_mask - (address & region_mask) + 1);
+
+		/* Last region can be smaller, then span wraps to first region */
+		if (shared->size - address < step) step = shared->size - address;
+
+		if (step >= length) break;
+
+		length -= step;
+		address = advance_shared_memory_address(shared, address, step);
+	}
+}
+
+/** \fn read_shared_memory_area_span
+ * This function copies given count of bytes from shared area, starting at
+ * given address, to given memory. Addresses wrap at end of area.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address in shared area to read from
+ * @*data Memory to read to
+ * @length Count of bytes to read
+ */
+void read_shared_memory_area_span(
+    shared_memory_t *shared,
+    uint8_t address,
+    char *data,
+    uint8_t length
+) {
+	volatile char *source = shared->area + wrap_shared_memory_address(
+		shared,
+		address
+	);
+	volatile char *end = shared->area + shared->size;
+
+	while (length--) {
+		*data++ = *source++;
+
+		if (source == end) source = shared->area;
+	}
+}
+
+/** \fn write_shared_memory_area_span
+ * This function copies given count of bytes from given memory to shared
+ * area, starting at given address. Addresses wrap at end of area.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address in shared area to write to
+ * @*data Memory to write from
+ * @length Count of bytes to write
+ */
+void write_shared_memory_area_span(
+    shared_memory_t *shared,
+    uint8_t address,
+    const char *data,
+    uint8_t length
+) {
+	address = wrap_shared_memory_address(shared, address);
+
+	mark_shared_memory_span_dirty(shared, address, length);
+
+	volatile char *target = shared->area + address;
+	volatile char *end = shared->area + shared->size;
+
+	while (length--) {
+		*target++ = *data++;
+
+		if (target == end) target = shared->area;
+	}
+}
+
+/** \fn read_shared_memory_span
+ * This function read sequence of given count of bytes from shared memory
+ * using pointer as address, and moves pointer after them.
+ * @*shared Pointer to shared memory for work on it
+ * @*data Memory to read to
+ * @length Count of bytes to read
+ */
+void read_shared_memory_span(
+    shared_memory_t *shared,
+    char *data,
+    uint8_t length
+) {
+	if (shared->pointer >= shared->size) shared->pointer = 0;
+
+	read_shared_memory_area_span(shared, shared->pointer, data, length);
+	skip_shared_memory(shared, length);
+}
+
+/** \fn write_shared_memory_span
+ * This function write sequence of given count of bytes to shared memory
+ * using pointer as address, and moves pointer after them.
+ * @*shared Pointer to shared memory for work on it
+ * @*data Memory to write from
+ * @length Count of bytes to write
+ */
+void write_shared_memory_span(
+    shared_memory_t *shared,
+    const char *data,
+    uint8_t length
+) {
+	if (shared->pointer >= shared->size) shared->pointer = 0;
+
+	write_shared_memory_area_span(shared, shared->pointer, data, length);
+	skip_shared_memory(shared, length);
+}
+
+/** \fn skip_shared_memory
+ * This function moves shared memory pointer by given count of bytes,
+ * without reading or writing them.
+ * @*shared Pointer to shared memory for work on it
+ * @length Count of bytes to skip
+ */
+void skip_shared_memory(shared_memory_t *shared, uint8_t length) {
+	if (shared->pointer >= shared->size) shared->pointer = 0;
+
+	shared->pointer = advance_shared_memory_address(
+		shared,
+		shared->pointer,
+		length
+	);
+}
+
+/** \fn read_shared_memory_snapshot
+ * This function copies given count of bytes from shared area, starting at
+ * given address, to given memory, without disabling interrupts. Return true
+ * when copy is consistent, or false when writer was changing area before
+ * or during copy. Process should then try again later, for example return
+ * IDLE_STATE. It must not be used by interrupt, when writer is process.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address in shared area to read from
+ * @*data Memory to read to
+ * @length Count of bytes to read
+ */
+bool read_shared_memory_snapshot(
+    shared_memory_t *shared,
+    uint8_t address,
+    char *data,
+    uint8_t length
+) {
+	uint8_t sequence = shared->sequence;
+
+	if (sequence & 0x01) return false;
+
+	read_shared_memory_area_span(shared, address, data, length);
+
+	return (bool) (shared->sequence == sequence);
+}
+
+/** \fn write_shared_memory_snapshot
+ * This function copies given count of bytes from given memory to shared
+ * area, starting at given address, so readers of snapshot see all of them
+ * or none of them.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address in shared area to write to
+ * @*data Memory to write from
+ * @length Count of bytes to write
+ */
+void write_shared_memory_snapshot(
+    shared_memory_t *shared,
+    uint8_t address,
+    const char *data,
+    uint8_t length
+) {
+	begin_shared_memory_write(shared);
+	write_shared_memory_area_span(shared, address, data, length);
+	end_shared_memory_write(shared);
+}
+
+/** \fn enable_shared_memory_tracking
+ * This function enables tracking of changed regions of shared memory. Every
+ * write marks its region dirty, and makes signal of region when it is set.
+ * @*shared Pointer to shared memory for work on it
+ * @*dirty Memory for dirty flags, SHARED_MEMORY_REGIONS bytes
+ * @region_shift Size of region is 2 to power of it bytes
+ * @region_signal Signal for first region, next regions have next signals,
+ * or 0x00 when no signals should be made. Return false, and tracking is not
+ * enabled, when signals of regions pass 0xFF or reach signals of drivers.
+ */
+bool enable_shared_memory_tracking(
+    shared_memory_t *shared,
+    volatile uint8_t *dirty,
+    uint8_t region_shift,
+    signal_t region_signal
+) {
+	uint8_t regions = SHARED_MEMORY_REGIONS(shared->size, region_shift);
+
+	if (region_signal != 0x00) {
+		uint16_t last_signal = (uint16_t) region_signal + regions - 1;
+
+		if (last_signal > 0xFF) return false;
+
+		if (
+		    region_signal <= DRIVER_SIGNALS_LAST
+		    && last_signal >= DRIVER_SIGNALS_FIRST
+		) {
+			return false;
+		}
+	}
+
+	for (uint8_t region = 0; region < regions; ++ region) dirty[region] = 0x00;
+
+	shared->region_shift = region_shift;
+	shared->region_signal = region_signal;
+	shared->dirty = dirty;
+
+	return true;
+}
+
+/** \fn take_dirty_shared_memory_region
+ * This function returns first dirty region and marks it clean, or returns
+ * SHARED_MEMORY_NO_REGION. Region is marked clean before it is processed,
+ * so write during processing marks it dirty again and is not lost.
+ * @*shared Pointer to shared memory for work on it
+ */
+uint8_t take_dirty_shared_memory_region(shared_memory_t *shared) {
+	if (shared->dirty == nullptr) return SHARED_MEMORY_NO_REGION;
+
+	uint8_t regions = SHARED_MEMORY_REGIONS(shared->size, shared->region_shift);
+
+	for (uint8_t region = 0; region < regions; ++ region) {
+		if (!shared->dirty[region]) continue;
+
+		shared->dirty[region] = 0x00;
+
+		return region;
+	}
+
+	return SHARED_MEMORY_NO_REGION;
 }
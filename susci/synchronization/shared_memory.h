@@ -17,36 +17,187 @@
  * a pointer, it's optional.
  */
 
-#include "../settings.h"
 #include "../kernel/types.h"
+#include "../kernel/interface.h"
 
 #ifndef COMMUNICATION_SHARED_MEMORY_H_INCLUDED
 #define COMMUNICATION_SHARED_MEMORY_H_INCLUDED
 
-/** \def SHARED_MEMORY_NULLPTR
- * NULLPTR in shared memory.
- */
-#define SHARED_MEMORY_NULLPTR SHARED_MEMORY_SIZE
-
 /** \struct shared_memory_t
  * This structure allows you to store Shared Memory, it stores the pointer
- * and just the shared memory.
+ * and pointer to the shared memory. Pointer equal to size is null.
  */
 typedef struct {
 
     /* Pointer used when accessing in sequence */
 	volatile uint8_t pointer;
 
+    /* Size of shared memory in bytes */
+	uint8_t size;
+
 	/* Memory space that is shared */
-	volatile char area[SHARED_MEMORY_SIZE];
+	volatile char *area;
+
+	/* Sequence counter, it is odd while writer is changing area */
+	volatile uint8_t sequence;
+
+	/* Dirty flag for every region, nullptr when regions are not tracked */
+	volatile uint8_t *dirty;
+
+	/* Size of region is 2 to power of region_shift bytes */
+	uint8_t region_shift;
+
+	/* Signal for first region, next regions have next signals, or 0x00 */
+	signal_t region_signal;
 
 } shared_memory_t;
 
+/** \def SHARED_MEMORY_REGIONS
+ * Count of regions in shared memory of given size, with regions of 2 to
+ * power of given shift bytes. Use it for size of dirty flags memory.
+ */
+#define SHARED_MEMORY_REGIONS(size, region_shift) \
+    ((((size) - 1) >> (region_shift)) + 1)
+
+/** \def SHARED_MEMORY_NO_REGION
+ * Returned when there is no dirty region.
+ */
+#define SHARED_MEMORY_NO_REGION 0xFF
+
+/** \def DECLARE_SHARED_MEMORY
+ * Declares shared memory with given name and size in bytes, with pointer
+ * set to null. Memory space is named name_area. Compilation fails when size
+ * is bigger than 255 bytes.
+ */
+#define DECLARE_SHARED_MEMORY(name, size) \
+    volatile char name##_area[size]; \
+    shared_memory_t name = { \
+        sizeof(name##_area), \
+        sizeof(name##_area) + compile_time_check(sizeof(name##_area) <= 255), \
+        name##_area, \
+        0x00, \
+        nullptr, \
+        0x00, \
+        0x00 \
+    }
+
 /** \fn create_shared_memory
- * This function create and return new SharedMemory with pointer set to null.
+ * This function create and return new SharedMemory on given memory space,
+ * with pointer set to null.
+ * @*area Memory space to share
+ * @size Size of memory space in bytes
+ */
+static inline shared_memory_t create_shared_memory(
+    volatile char *area,
+    uint8_t size
+) {
+	return (shared_memory_t) {size, size, area, 0x00, nullptr, 0x00, 0x00};
+}
+
+/** \fn enable_shared_memory_tracking
+ * This function enables tracking of changed regions of shared memory. Every
+ * write marks its region dirty, and makes signal of region when it is set.
+ * @*shared Pointer to shared memory for work on it
+ * @*dirty Memory for dirty flags, SHARED_MEMORY_REGIONS bytes
+ * @region_shift Size of region is 2 to power of it bytes
+ * @region_signal Signal for first region, next regions have next signals,
+ * or 0x00 when no signals should be made. Return false, and tracking is not
+ * enabled, when signals of regions pass 0xFF or reach signals of drivers.
+ */
+bool enable_shared_memory_tracking(
+    shared_memory_t *shared,
+    volatile uint8_t *dirty,
+    uint8_t region_shift,
+    signal_t region_signal
+);
+
+/** \fn mark_shared_memory_dirty
+ * This function marks region with given address dirty, when regions are
+ * tracked, and makes signal when region was clean.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address in shared area that has been written
+ */
+static inline void mark_shared_memory_dirty(
+    shared_memory_t *shared,
+    uint8_t address
+) {
+	if (shared->dirty == nullptr) return;
+
+	uint8_t region = address >> shared->region_shift;
+
+	if (shared->dirty[region]) return;
+
+	shared->dirty[region] = 0x01;
+
+	if (shared->region_signal != 0x00) {
+		make_signal(shared->region_signal + region);
+	}
+}
+
+/** \fn take_dirty_shared_memory_region
+ * This function returns first dirty region and marks it clean, or returns
+ * SHARED_MEMORY_NO_REGION. Region is marked clean before it is processed,
+ * so write during processing marks it dirty again and is not lost.
+ * @*shared Pointer to shared memory for work on it
+ */
+uint8_t take_dirty_shared_memory_region(shared_memory_t *shared);
+
+/** \fn is_shared_memory_region_dirty
+ * This function returns true when given region has been written since it
+ * was taken.
+ * @*shared Pointer to shared memory for work on it
+ * @region Region to check
+ */
+static inline bool is_shared_memory_region_dirty(
+    shared_memory_t *shared,
+    uint8_t region
+) {
+	return (bool) (shared->dirty[region] != 0x00);
+}
+
+/** \fn get_shared_memory_region_address
+ * This function returns first address of given region.
+ * @*shared Pointer to shared memory for work on it
+ * @region Region to get address of
+ */
+static inline uint8_t get_shared_memory_region_address(
+    shared_memory_t *shared,
+    uint8_t region
+) {
+	return (uint8_t) (region << shared->region_shift);
+}
+
+/** \fn get_shared_memory_region_length
+ * This function returns size of given region in bytes, last region can be
+ * smaller than others.
+ * @*shared Pointer to shared memory for work on it
+ * @region Region to get size of
+ */
+static inline uint8_t get_shared_memory_region_length(
+    shared_memory_t *shared,
+    uint8_t region
+) {
+	uint8_t address = get_shared_memory_region_address(shared, region);
+	uint8_t length = (uint8_t) (1 << shared->region_shift);
+
+	if (shared->size - address < length) length = shared->size - address;
+
+	return length;
+}
+
+/** \fn wrap_shared_memory_address
+ * This function wraps address given in parameter to the shared area. It
+ * divides only when address is out of area.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address to wrap
  */
-static inline shared_memory_t create_shared_memory(void) {
-	return (shared_memory_t) {SHARED_MEMORY_NULLPTR, {0x00}};
+static inline uint8_t wrap_shared_memory_address(
+    shared_memory_t *shared,
+    uint8_t address
+) {
+	if (address >= shared->size) address %= shared->size;
+
+	return address;
 }
 
 /** \fn reset_shared_memory_area
@@ -61,7 +212,7 @@ void reset_shared_memory_area(shared_memory_t *shared);
  * @*shared Pointer to shared memory for work on it
  */
 static inline void reset_shared_memory_pointer(shared_memory_t *shared) {
-	shared->pointer = SHARED_MEMORY_NULLPTR;
+	shared->pointer = shared->size;
 }
 
 /** \fn is_set_shared_memory_pointer
@@ -70,7 +221,7 @@ static inline void reset_shared_memory_pointer(shared_memory_t *shared) {
  * @*shared Pointer to shared memory for work on it
  */
 static inline bool is_set_shared_memory_pointer(shared_memory_t *shared) {
-	return (bool) (shared->pointer != SHARED_MEMORY_NULLPTR);
+	return (bool) (shared->pointer != shared->size);
 }
 
 /** \fn set_shared_memory_pointer
@@ -82,7 +233,7 @@ static inline void set_shared_memory_pointer(
     shared_memory_t *shared, 
     uint8_t address
 ) {
-	shared->pointer = address % SHARED_MEMORY_SIZE;
+	shared->pointer = wrap_shared_memory_address(shared, address);
 }
 
 /** \fn read_shared_memory_area
@@ -94,7 +245,7 @@ static inline char read_shared_memory_area(
     shared_memory_t *shared, 
     uint8_t address
 ) {
-	return shared->area[address % SHARED_MEMORY_SIZE];
+	return shared->area[wrap_shared_memory_address(shared, address)];
 }
 
 /** \fn write_shared_memory_area
@@ -108,7 +259,37 @@ static inline void write_shared_memory_area(
     uint8_t address, 
     char data
 ) {
-	shared->area[address % SHARED_MEMORY_SIZE] = data;
+	address = wrap_shared_memory_address(shared, address);
+
+	shared->area[address] = data;
+	mark_shared_memory_dirty(shared, address);
+}
+
+/** \fn begin_shared_memory_write
+ * This function marks that writer starts changing shared area, snapshots
+ * read until end_shared_memory_write will fail. It must not be nested.
+ * @*shared Pointer to shared memory for work on it
+ */
+static inline void begin_shared_memory_write(shared_memory_t *shared) {
+	++ shared->sequence;
+	compiler_barrier();
+}
+
+/** \fn end_shared_memory_write
+ * This function marks that writer ends changing shared area.
+ * @*shared Pointer to shared memory for work on it
+ */
+static inline void end_shared_memory_write(shared_memory_t *shared) {
+	compiler_barrier();
+	++ shared->sequence;
+}
+
+/** \fn is_shared_memory_writing
+ * This function returns true when writer is changing shared area.
+ * @*shared Pointer to shared memory for work on it
+ */
+static inline bool is_shared_memory_writing(shared_memory_t *shared) {
+	return (bool) (shared->sequence & 0x01);
 }
 
 /** \fn read_shared_memory
@@ -126,4 +307,102 @@ char read_shared_memory(shared_memory_t *shared);
  */
 void write_shared_memory(shared_memory_t *shared, char data);
 
+/** \fn read_shared_memory_area_span
+ * This function copies given count of bytes from shared area, starting at
+ * given address, to given memory. Addresses wrap at end of area.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address in shared area to read from
+ * @*data Memory to read to
+ * @length Count of bytes to read
+ */
+void read_shared_memory_area_span(
+    shared_memory_t *shared,
+    uint8_t address,
+    char *data,
+    uint8_t length
+);
+
+/** \fn write_shared_memory_area_span
+ * This function copies given count of bytes from given memory to shared
+ * area, starting at given address. Addresses wrap at end of area.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address in shared area to write to
+ * @*data Memory to write from
+ * @length Count of bytes to write
+ */
+void write_shared_memory_area_span(
+    shared_memory_t *shared,
+    uint8_t address,
+    const char *data,
+    uint8_t length
+);
+
+/** \fn read_shared_memory_span
+ * This function read sequence of given count of bytes from shared memory
+ * using pointer as address, and moves pointer after them.
+ * @*shared Pointer to shared memory for work on it
+ * @*data Memory to read to
+ * @length Count of bytes to read
+ */
+void read_shared_memory_span(
+    shared_memory_t *shared,
+    char *data,
+    uint8_t length
+);
+
+/** \fn write_shared_memory_span
+ * This function write sequence of given count of bytes to shared memory
+ * using pointer as address, and moves pointer after them.
+ * @*shared Pointer to shared memory for work on it
+ * @*data Memory to write from
+ * @length Count of bytes to write
+ */
+void write_shared_memory_span(
+    shared_memory_t *shared,
+    const char *data,
+    uint8_t length
+);
+
+/** \fn skip_shared_memory
+ * This function moves shared memory pointer by given count of bytes,
+ * without reading or writing them.
+ * @*shared Pointer to shared memory for work on it
+ * @length Count of bytes to skip
+ */
+void skip_shared_memory(shared_memory_t *shared, uint8_t length);
+
+/** \fn read_shared_memory_snapshot
+ * This function copies given count of bytes from shared area, starting at
+ * given address, to given memory, without disabling interrupts. Return true
+ * when copy is consistent, or false when writer was changing area before
+ * or during copy. Process should then try again later, for example return
+ * IDLE_STATE. It must not be used by interrupt, when writer is process.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address in shared area to read from
+ * @*data Memory to read to
+ * @length Count of bytes to read
+ */
+bool read_shared_memory_snapshot(
+    shared_memory_t *shared,
+    uint8_t address,
+    char *data,
+    uint8_t length
+);
+
+/** \fn write_shared_memory_snapshot
+ * This function copies given count of bytes from given memory to shared
+ * area, starting at given address, so readers of snapshot see all of them
+ * or none of them.
+ * @*shared Pointer to shared memory for work on it
+ * @address Address in shared area to write to
+ * @*data Memory to write from
+ * @length Count of bytes to write
+ */
+void write_shared_memory_snapshot(
+    shared_memory_t *shared,
+    uint8_t address,
+    const char *data,
+    uint8_t length
+);
+
 #endif
@@ -0,0 +1,130 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores declarations and definitions of data structures and
+ * functions responsibles for Topic in system. Publisher posts small value,
+ * or pointer to bigger one, to topic and makes its signal. Every process
+ * that waits for this signal is run by signal scheduler, and reads the
+ * same latest value, so there is no copy for every subscriber.
+ */
+
+#include "../kernel/types.h"
+#include "../kernel/process.h"
+#include "../kernel/scheduler.h"
+#include "../kernel/interface.h"
+#include "topic.h"
+
+/** \fn begin_publish
+ * This function marks that publisher starts changing value of topic.
+ * @*topic Topic object
+ */
+static inline void begin_publish(topic_t *topic) {
+    ++ topic->sequence;
+    compiler_barrier();
+}
+
+/** \fn end_publish
+ * This function marks that publisher ends changing value of topic, and
+ * makes signal of topic, when it has one.
+ * @*topic Topic object
+ */
+static inline void end_publish(topic_t *topic) {
+    compiler_barrier();
+    ++ topic->sequence;
+
+    if (topic->signal != 0x00) make_signal(topic->signal);
+}
+
+/** \fn read_topic_value
+ * This function reads value of subscribed topic, again when publisher
+ * changed it while reading, and marks it read.
+ * @*subscription Subscription object
+ */
+static topic_value_t read_topic_value(subscription_t *subscription) {
+    topic_t *topic = subscription->topic;
+    topic_value_t data;
+    uint8_t sequence;
+
+    do {
+        sequence = topic->sequence;
+        compiler_barrier();
+        data = topic->data;
+        compiler_barrier();
+    } while ((sequence & 0x01) || sequence != topic->sequence);
+
+    subscription->sequence = sequence;
+
+    return data;
+}
+
+/** \fn publish_topic
+ * This function publishes new small value to topic, and makes its signal.
+ * @*topic Topic object
+ * @value New value
+ */
+void publish_topic(topic_t *topic, uint16_t value) {
+    begin_publish(topic);
+    topic->data.value = value;
+    end_publish(topic);
+}
+
+/** \fn publish_topic_pointer
+ * This function publishes pointer to new data to topic, and makes its
+ * signal. Data must not change until next publish.
+ * @*topic Topic object
+ * @*pointer Pointer to new data
+ */
+void publish_topic_pointer(topic_t *topic, const void *pointer) {
+    begin_publish(topic);
+    topic->data.pointer = pointer;
+    end_publish(topic);
+}
+
+/** \fn read_topic
+ * This function returns latest small value from subscribed topic, and
+ * marks it read.
+ * @*subscription Subscription object
+ */
+uint16_t read_topic(subscription_t *subscription) {
+    return read_topic_value(subscription).value;
+}
+
+/** \fn read_topic_pointer
+ * This function returns latest pointer from subscribed topic, and marks it
+ * read.
+ * @*subscription Subscription object
+ */
+const void *read_topic_pointer(subscription_t *subscription) {
+    return read_topic_value(subscription).pointer;
+}
+
+/** \fn wait_for_topic
+ * This function sets current process waiting for signal of subscribed
+ * topic. When value has been published since it was read, process stays
+ * ready, so publish made while process was running is not missed. System
+ * has one signal slot, so signal can be overwritten by other one, then
+ * subscriber should check is_topic_updated, for example also on timer.
+ * Topic without signal can not wake process, so it stays ready.
+ * @*subscription Subscription object
+ */
+void wait_for_topic(subscription_t *subscription) {
+    if (
+        is_topic_updated(subscription)
+        || subscription->topic->signal == 0x00
+    ) {
+        current_process->state = READY_STATE;
+
+        return;
+    }
+
+    wait_for_signal(subscription->topic->signal);
+}
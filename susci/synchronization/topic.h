@@ -0,0 +1,144 @@
+/*
+ * This file is part of the Susci project, an ultra lightweight general purpose
+ * operating system aimed at devices without an MMU module and with very little
+ * RAM memory.
+ *
+ * It is released under the terms of the MIT license, you can use Susca in your
+ * projects, you just need to mention it in the documentation, manual or other
+ * such place.
+ *
+ * Author: Cixo
+ *
+ *
+ * This file stores declarations and definitions of data structures and
+ * functions responsibles for Topic in system. Publisher posts small value,
+ * or pointer to bigger one, to topic and makes its signal. Every process
+ * that waits for this signal is run by signal scheduler, and reads the
+ * same latest value, so there is no copy for every subscriber.
+ */
+
+#include "../kernel/types.h"
+
+#ifndef SYNCHRONIZATION_TOPIC_H_INCLUDED
+#define SYNCHRONIZATION_TOPIC_H_INCLUDED
+
+/** \union topic_value_t
+ * Value stored in topic, small value or pointer to data of publisher.
+ */
+typedef union {
+
+    /* Small value */
+    uint16_t value;
+
+    /* Pointer to data, that must be valid until next publish */
+    const void *pointer;
+
+} topic_value_t;
+
+/** \struct topic_t
+ * Type for Topic. It has one publisher, that can be interrupt or process.
+ */
+typedef struct {
+
+    /* Latest published value */
+    volatile topic_value_t data;
+
+    /* Sequence counter, it is odd while publisher is changing value */
+    volatile uint8_t sequence;
+
+    /* Signal made after every publish, 0x00 when none */
+    signal_t signal;
+
+} topic_t;
+
+/** \struct subscription_t
+ * Type for Subscription of topic. Every subscriber has own one, it stores
+ * which value subscriber has already read.
+ */
+typedef struct {
+
+    /* Topic that is subscribed */
+    topic_t *topic;
+
+    /* Sequence of last read value */
+    uint8_t sequence;
+
+} subscription_t;
+
+/** \def DECLARE_TOPIC
+ * Declares topic with given name, with no value published, that makes
+ * given signal after every publish.
+ */
+#define DECLARE_TOPIC(name, signal) \
+    topic_t name = {{0x00}, 0x00, signal}
+
+/** \fn create_topic
+ * This function creating topic with no value published, that makes given
+ * signal after every publish, and returning it.
+ * @signal Signal made after every publish, 0x00 when none
+ */
+static inline topic_t create_topic(signal_t signal) {
+    return (topic_t) {{0x00}, 0x00, signal};
+}
+
+/** \fn create_subscription
+ * This function creating subscription of given topic and returning it.
+ * Value that is already published is not new for it.
+ * @*topic Topic to subscribe
+ */
+static inline subscription_t create_subscription(topic_t *topic) {
+    return (subscription_t) {topic, (uint8_t) (topic->sequence & 0xFE)};
+}
+
+/** \fn publish_topic
+ * This function publishes new small value to topic, and makes its signal.
+ * @*topic Topic object
+ * @value New value
+ */
+void publish_topic(topic_t *topic, uint16_t value);
+
+/** \fn publish_topic_pointer
+ * This function publishes pointer to new data to topic, and makes its
+ * signal. Data must not change until next publish.
+ * @*topic Topic object
+ * @*pointer Pointer to new data
+ */
+void publish_topic_pointer(topic_t *topic, const void *pointer);
+
+/** \fn read_topic
+ * This function returns latest small value from subscribed topic, and
+ * marks it read.
+ * @*subscription Subscription object
+ */
+uint16_t read_topic(subscription_t *subscription);
+
+/** \fn read_topic_pointer
+ * This function returns latest pointer from subscribed topic, and marks it
+ * read.
+ * @*subscription Subscription object
+ */
+const void *read_topic_pointer(subscription_t *subscription);
+
+/** \fn is_topic_updated
+ * This function returns true when value has been published to topic since
+ * subscriber read it last time.
+ * @*subscription Subscription object
+ */
+static inline bool is_topic_updated(subscription_t *subscription) {
+    return (bool) (
+        (subscription->topic->sequence & 0xFE) != subscription->sequence
+    );
+}
+
+/** \fn wait_for_topic
+ * This function sets current process waiting for signal of subscribed
+ * topic. When value has been published since it was read, process stays
+ * ready, so publish made while process was running is not missed. System
+ * has one signal slot, so signal can be overwritten by other one, then
+ * subscriber should check is_topic_updated, for example also on timer.
+ * Topic without signal can not wake process, so it stays ready.
+ * @*subscription Subscription object
+ */
+void wait_for_topic(subscription_t *subscription);
+
+#endif
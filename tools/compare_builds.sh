@@ -0,0 +1,44 @@
+#!/bin/sh
+#
+# This file is part of the Susci project, an ultra lightweight general purpose
+# operating system aimed at devices without an MMU module and with very little
+# RAM memory.
+#
+# It is released under the terms of the MIT license, you can use Susca in your
+# projects, you just need to mention it in the documentation, manual or other
+# such place.
+#
+# Author: Cixo
+#
+#
+# This script compares images built in different build modes, it is called
+# by the compare_builds target of the Makefile.
+#
+#   compare_builds.sh SIZE "CYCLE_COMMAND" PREFIX MODE...
+#
+# Image of every mode must be in PREFIX_MODE.bin. When CYCLE_COMMAND is not
+# empty, it is run with image as last parameter, and last line of its output
+# is printed as cycle count (for example simulator running benchmark).
+#
+
+set -e
+
+size="$1"
+cycle_command="$2"
+prefix="$3"
+shift 3
+
+printf "%-16s %8s %8s %8s %12s\n" mode text data bss cycles
+
+for mode in "$@"; do
+    image="${prefix}_${mode}.bin"
+    cycles="-"
+
+    if [ -n "$cycle_command" ]; then
+        cycles=$($cycle_command "$image" | tail -n 1)
+    fi
+
+    "$size" -B "$image" | awk -v mode="$mode" -v cycles="$cycles" '
+        NR == 2 { printf "%-16s %8d %8d %8d %12s\n", mode, $1, $2, $3, cycles }
+    '
+done
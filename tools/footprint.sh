@@ -0,0 +1,211 @@
+#!/bin/sh
+#
+# This file is part of the Susci project, an ultra lightweight general purpose
+# operating system aimed at devices without an MMU module and with very little
+# RAM memory.
+#
+# It is released under the terms of the MIT license, you can use Susca in your
+# projects, you just need to mention it in the documentation, manual or other
+# such place.
+#
+# Author: Cixo
+#
+#
+# This script reports flash and RAM footprint of the system, it is called by
+# the footprint and budget targets of the Makefile.
+#
+#   footprint.sh modules MAP_FILE
+#       Flash (.text), .data and .bss per module, read from linker map.
+#
+#   footprint.sh options SIZE "CC CC_FLAGS" "SOURCES" OPTION...
+#       Cost of every config option, as difference against build without it.
+#
+#   footprint.sh budget SIZE ELF FLASH_BUDGET RAM_BUDGET [MAP_FILE BUDGET_FILE]
+#       Compare totals, and optionally modules, with budgets. Budget file has
+#       lines "module flash_budget ram_budget", # starts comment.
+#
+
+set -e
+
+# Prints "module text data bss" for every module found in linker map
+map_modules() {
+    awk '
+    function hex(value,    digits, result, position) {
+        digits = tolower(substr(value, 3))
+        result = 0
+
+        for (position = 1; position <= length(digits); ++ position) {
+            result = result * 16 \
+                + index("0123456789abcdef", substr(digits, position, 1)) - 1
+        }
+
+        return result
+    }
+
+    function module(file) {
+        if (file ~ /susci\//) {
+            sub(/.*susci\//, "", file)
+            sub(/\.o$/, "", file)
+            return file
+        }
+
+        if (file ~ /libgcc|libc|libm|crt/) return "runtime"
+
+        return "application"
+    }
+
+    function record(size, file,    name) {
+        if (output == "") return
+
+        name = module(file)
+        names[name] = 1
+        sizes[name, output] += hex(size)
+    }
+
+    /^Linker script and memory map/ { started = 1; next }
+
+    !started { next }
+
+    /^\.[A-Za-z]/ {
+        output = ""
+        if ($1 == ".text") output = "text"
+        if ($1 == ".data") output = "data"
+        if ($1 == ".bss" || $1 == ".noinit") output = "bss"
+        pending = 0
+        next
+    }
+
+    /^ [.A-Za-z]/ {
+        pending = 0
+
+        if (NF >= 4 && $2 ~ /^0x/ && $3 ~ /^0x/) record($3, $4)
+        else if (NF == 1) pending = 1
+
+        next
+    }
+
+    pending && /^  *0x/ {
+        pending = 0
+
+        if (NF >= 3 && $2 ~ /^0x/) record($2, $3)
+
+        next
+    }
+
+    { pending = 0 }
+
+    END {
+        for (name in names) {
+            printf "%s %d %d %d\n", name, \
+                sizes[name, "text"], sizes[name, "data"], sizes[name, "bss"]
+        }
+    }
+    ' "$1"
+}
+
+# Prints "flash ram" of given elf, flash is .text + .data, ram .data + .bss
+elf_size() {
+    "$1" -B "$2" | awk 'NR == 2 { print $1 + $2, $2 + $3 }'
+}
+
+command="$1"
+shift
+
+case "$command" in
+
+    modules)
+        printf "%-40s %8s %8s %8s\n" module flash data bss
+        map_modules "$1" | sort | awk '{
+            printf "%-40s %8d %8d %8d\n", $1, $2 + $3, $3, $4
+            flash += $2 + $3; data += $3; bss += $4
+        } END {
+            printf "%-40s %8d %8d %8d\n", "total", flash, data, bss
+        }'
+    ;;
+
+    options)
+        size="$1"
+        compiler="$2"
+        sources="$3"
+        shift 3
+
+        output="footprint_option.elf"
+
+        $compiler $sources -o "$output"
+        base=$(elf_size "$size" "$output")
+
+        printf "%-40s %8s %8s\n" option flash ram
+        printf "%-40s %8s %8s\n" "(base)" $base
+
+        for option in "$@"; do
+            if $compiler "-D$option" $sources -o "$output" 2>/dev/null; then
+                echo "$option $(elf_size "$size" "$output") $base" \
+                    | awk '{ printf "%-40s %+8d %+8d\n", $1, $2 - $4, $3 - $5 }'
+            else
+                printf "%-40s %17s\n" "$option" "does not build"
+            fi
+        done
+
+        rm -f "$output"
+    ;;
+
+    budget)
+        size="$1"
+        elf="$2"
+        flash_budget="$3"
+        ram_budget="$4"
+        map="$5"
+        budget_file="$6"
+
+        result=0
+
+        set -- $(elf_size "$size" "$elf")
+        printf "flash %d / %d bytes\n" "$1" "$flash_budget"
+        printf "ram   %d / %d bytes\n" "$2" "$ram_budget"
+
+        if [ "$1" -gt "$flash_budget" ]; then
+            echo "flash budget exceeded" >&2
+            result=1
+        fi
+
+        if [ "$2" -gt "$ram_budget" ]; then
+            echo "ram budget exceeded" >&2
+            result=1
+        fi
+
+        if [ -n "$budget_file" ] && [ -f "$budget_file" ]; then
+            map_modules "$map" | awk -v budget_file="$budget_file" '
+            BEGIN {
+                while ((getline line < budget_file) > 0) {
+                    sub(/#.*/, "", line)
+                    if (split(line, field) < 3) continue
+                    flash_budget[field[1]] = field[2]
+                    ram_budget[field[1]] = field[3]
+                }
+            }
+
+            ($1 in flash_budget) {
+                flash = $2 + $3
+                ram = $3 + $4
+
+                if (flash > flash_budget[$1] || ram > ram_budget[$1]) {
+                    printf "%s over budget: flash %d / %d, ram %d / %d\n", \
+                        $1, flash, flash_budget[$1], ram, ram_budget[$1] \
+                        > "/dev/stderr"
+                    failed = 1
+                }
+            }
+
+            END { exit failed }
+            ' || result=1
+        fi
+
+        exit $result
+    ;;
+
+    *)
+        echo "usage: $0 modules|options|budget ..." >&2
+        exit 1
+    ;;
+
+esac
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+#
+# This file is part of the Susci project, an ultra lightweight general purpose
+# operating system aimed at devices without an MMU module and with very little
+# RAM memory.
+#
+# It is released under the terms of the MIT license, you can use Susca in your
+# projects, you just need to mention it in the documentation, manual or other
+# such place.
+#
+# Author: Cixo
+#
+#
+# This script renders binary log of the system as text. It reads formats of
+# messages from log_messages.h, so it must be the same file that firmware
+# was built with, and records from file or stdin, for example serial port.
+#
+#   log_decoder.py MESSAGES_FILE [LOG_FILE]
+#
+# Every record is LOG_SYNC, id, length of arguments and raw little endian
+# arguments. Bytes that are not record, for example other uart output, are
+# skipped. Records are printed as soon as they come, so it can follow live
+# serial port.
+#
+
+import re
+import sys
+
+LOG_SYNC = 0xA5
+
+MESSAGE = re.compile(r'^\s*LOG_MESSAGE\s*\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"')
+SPECIFIER = re.compile(r'%([-+ #0]*\d*)(hh|l)?([cdiuxX%])')
+
+SIZES = {'hh': 1, '': 2, 'l': 4}
+
+
+def read_messages(path):
+    """Returns list of (name, format) in order of ids."""
+    messages = []
+
+    with open(path) as file:
+        for line in file:
+            match = MESSAGE.match(line)
+
+            if match:
+                messages.append((match.group(1), match.group(2)))
+
+    return messages
+
+
+def argument_sizes(message_format):
+    """Returns sizes and signedness of arguments of given format."""
+    sizes = []
+
+    for flags, length, conversion in SPECIFIER.findall(message_format):
+        if conversion == '%':
+            continue
+
+        size = 1 if conversion == 'c' else SIZES[length or '']
+        sizes.append((size, conversion in 'di'))
+
+    return sizes
+
+
+def render(message_format, arguments):
+    """Returns text of message with given raw arguments."""
+    values = []
+    position = 0
+
+    for size, signed in argument_sizes(message_format):
+        raw = arguments[position:position + size]
+        position += size
+
+        if len(raw) < size:
+            return '%s <bad arguments: %s>' % (message_format, arguments.hex())
+
+        values.append(int.from_bytes(raw, 'little', signed=signed))
+
+    text = SPECIFIER.sub(lambda match: '%' + match.group(1) + match.group(3),
+                         message_format)
+
+    return text % tuple(values)
+
+
+def decode_records(messages, data):
+    """Prints every complete record in data, returns count of used bytes."""
+    position = 0
+
+    while position + 3 <= len(data):
+        if data[position] != LOG_SYNC:
+            position += 1
+            continue
+
+        message_id, length = data[position + 1], data[position + 2]
+        end = position + 3 + length
+
+        if message_id >= len(messages):
+            position += 1
+            continue
+
+        if end > len(data):
+            break
+
+        name, message_format = messages[message_id]
+        text = render(message_format, data[position + 3:end])
+        print('%s: %s' % (name, text), flush=True)
+
+        position = end
+
+    return position
+
+
+def decode(messages, stream):
+    """Prints every record found in stream, as soon as it comes."""
+    read = getattr(stream, 'read1', stream.read)
+    data = bytearray()
+
+    while True:
+        chunk = read(256)
+
+        if not chunk:
+            break
+
+        data += chunk
+        del data[:decode_records(messages, data)]
+
+
+def main(arguments):
+    if len(arguments) not in (2, 3):
+        sys.stderr.write('log_decoder.py MESSAGES_FILE [LOG_FILE]\n')
+        return 1
+
+    messages = read_messages(arguments[1])
+
+    if len(arguments) == 3:
+        with open(arguments[2], 'rb') as stream:
+            decode(messages, stream)
+    else:
+        decode(messages, sys.stdin.buffer)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))